@@ -3,4 +3,19 @@
 #include "dv/pixel_format.hpp"
 #include "dv/interpolation.hpp"
 #include "dv/binaryzation.hpp"
-#include "dv/draw.hpp"
\ No newline at end of file
+#include "dv/draw.hpp"
+#include "dv/overlay.hpp"
+#include "dv/codec.hpp"
+#include "dv/pipeline.hpp"
+#include "dv/stream.hpp"
+#include "dv/sensor.hpp"
+#include "dv/planar.hpp"
+#include "dv/color.hpp"
+#include "dv/match.hpp"
+#include "dv/gradient.hpp"
+#include "dv/hough.hpp"
+#include "dv/undistort.hpp"
+#include "dv/transform.hpp"
+
+// 依赖操作系统的模块不在这里包含（无 FPU/无 OS 的目标也使用本头文件），按需单独包含：
+// dv/recording.hpp（POSIX mmap、后台写线程）、dv/batch.hpp（线程池，需要链接 Threads::Threads）
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "dv/image.hpp"
+#include "dv/binaryzation.hpp"
+#include "dv/stream.hpp"
+
+namespace dv
+{
+    namespace batch
+    {
+        using namespace image;
+        using namespace pixel_format;
+
+        // 固定数量的工作线程，run() 把 [0, tasks) 分给各线程（调用线程也参与）并等待全部完成。
+        // 线程在构造时创建，每帧调用 run() 不再创建线程或分配内存。
+        class WorkerPool
+        {
+        public:
+            // threads 为 0 时使用硬件线程数
+            explicit WorkerPool(size_t threads = 0)
+            {
+                if (threads == 0)
+                    threads = std::thread::hardware_concurrency();
+                threads_ = threads ? threads : 1;
+                for (size_t i = 1; i < threads_; ++i)
+                    workers_.emplace_back([this]
+                                          { loop_(); });
+            }
+
+            WorkerPool(const WorkerPool &) = delete;
+            WorkerPool &operator=(const WorkerPool &) = delete;
+
+            ~WorkerPool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stop_ = true;
+                }
+                cv_.notify_all();
+                for (auto &worker : workers_)
+                    worker.join();
+            }
+
+            size_t threads() const { return threads_; }
+
+            // fn(task) 对每个 task 调用一次，不同的 task 可能在不同线程上并行执行
+            template <typename Fn>
+            void run(size_t tasks, Fn &&fn)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    // 上一轮醒得晚的线程退出后才能重置任务计数
+                    done_cv_.wait(lock, [this]
+                                  { return active_ == 0; });
+                    fn_ = &fn;
+                    call_ = [](void *f, size_t task)
+                    { (*static_cast<std::remove_reference_t<Fn> *>(f))(task); };
+                    tasks_ = tasks;
+                    next_ = 0;
+                    pending_ = tasks;
+                    generation_++;
+                }
+                cv_.notify_all();
+                work_();
+                std::unique_lock<std::mutex> lock(mutex_);
+                done_cv_.wait(lock, [this]
+                              { return pending_ == 0 && active_ == 0; });
+            }
+
+        private:
+            void work_()
+            {
+                while (true)
+                {
+                    size_t task = next_.fetch_add(1);
+                    if (task >= tasks_)
+                        break;
+                    call_(fn_, task);
+                    if (pending_.fetch_sub(1) == 1)
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        done_cv_.notify_all();
+                    }
+                }
+            }
+
+            void loop_()
+            {
+                uint64_t seen = 0;
+                while (true)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        cv_.wait(lock, [&]
+                                 { return stop_ || generation_ != seen; });
+                        if (stop_)
+                            return;
+                        seen = generation_;
+                        active_++;
+                    }
+                    work_();
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    active_--;
+                    done_cv_.notify_all();
+                }
+            }
+
+            size_t threads_ = 1;
+            std::vector<std::thread> workers_;
+
+            std::mutex mutex_;
+            std::condition_variable cv_;
+            std::condition_variable done_cv_;
+            bool stop_ = false;
+            uint64_t generation_ = 0;
+            size_t active_ = 0;
+
+            void *fn_ = nullptr;
+            void (*call_)(void *, size_t) = nullptr;
+            size_t tasks_ = 0;
+            std::atomic<size_t> next_{0};
+            std::atomic<size_t> pending_{0};
+        };
+
+        struct StreamResult
+        {
+            uint8_t threshold;  // otsu 求出的阈值（threshold() 不填）
+            size_t foreground;  // 二值结果中的前景像素数
+        };
+
+        // 多路同尺寸相机的批处理：每个任务处理一路的一个行带，在带内直接调用逐行的内核，
+        // 同一个查找表（如 RGB565 -> LAB）在各任务之间保持在缓存中。
+        // 路数不少于线程数时每路一个带（整帧）；路数少于线程数时，每一路再按行分成若干带
+        // （8 行对齐，二值图的打包字节不会被两个线程共享）。
+        // 结果与逐路调用 image::image_cast / binaryzation::threshold / binaryzation::otsu 完全相同。
+        template <size_t WIDTH, size_t HEIGHT, size_t MAX_STREAMS = 8>
+        class BatchProcessor
+        {
+        public:
+            explicit BatchProcessor(size_t threads = 0)
+                : pool_(threads),
+                  hist_(MAX_STREAMS * pool_.threads() * binaryzation::OTSU_HIST_SIZE),
+                  foreground_(MAX_STREAMS * pool_.threads())
+            {
+            }
+
+            size_t threads() const { return pool_.threads(); }
+
+            template <PixelFormat SPF, PixelFormat DPF>
+            bool image_cast(const Image<SPF, WIDTH, HEIGHT> *const src[], Image<DPF, WIDTH, HEIGHT> *const dst[], size_t count)
+            {
+                if (count == 0 || count > MAX_STREAMS)
+                    return false;
+                using SrcT = typename PixelFormatTrait<SPF>::type;
+                using DstT = typename PixelFormatTrait<DPF>::type;
+                for_bands_(count, [&](size_t s, size_t, size_t y0, size_t y1)
+                           {
+                               // 带内的行在内存中连续，按一整段处理
+                               const SrcT *in = &(*src[s])(0, y0);
+                               DstT *out = &(*dst[s])(0, y0);
+                               const size_t n = (y1 - y0) * WIDTH;
+                               if constexpr (SPF == PixelFormat::RGB565 && Rgb565Lut<DstT>::enabled)
+                               {
+                                   const auto &table = Rgb565Lut<DstT>::table();
+                                   const uint16_t *words = reinterpret_cast<const uint16_t *>(in);
+                                   for (size_t i = 0; i < n; ++i)
+                                       out[i] = table[words[i]];
+                               }
+                               else
+                               {
+                                   for (size_t i = 0; i < n; ++i)
+                                       pixel_cast(in[i], out[i]);
+                               } });
+                return true;
+            }
+
+            // results 可以为空
+            template <PixelFormat PF, typename TPFT>
+            bool threshold(const Image<PF, WIDTH, HEIGHT> *const src[], Image<PixelFormat::Binary, WIDTH, HEIGHT> *const dst[],
+                           size_t count, TPFT t_low, TPFT t_high, StreamResult results[] = nullptr)
+            {
+                if (count == 0 || count > MAX_STREAMS)
+                    return false;
+                threshold_(src, dst, count, &t_low, &t_high, true, results != nullptr);
+                collect_(count, results, nullptr);
+                return true;
+            }
+
+            // 两遍：先按带累积各路直方图，再用各自的阈值二值化
+            bool otsu(const Image<PixelFormat::Grayscale, WIDTH, HEIGHT> *const src[],
+                      Image<PixelFormat::Binary, WIDTH, HEIGHT> *const dst[], size_t count, StreamResult results[] = nullptr)
+            {
+                if (count == 0 || count > MAX_STREAMS)
+                    return false;
+                std::fill(hist_.begin(), hist_.end(), 0);
+                for_bands_(count, [&](size_t s, size_t band, size_t y0, size_t y1)
+                           {
+                               size_t *hist = &hist_[(s * pool_.threads() + band) * binaryzation::OTSU_HIST_SIZE];
+                               const GrayscalePixel *in = &(*src[s])(0, y0);
+                               const size_t n = (y1 - y0) * WIDTH;
+                               for (size_t i = 0; i < n; ++i)
+                                   hist[in[i].value]++; });
+
+                GrayscalePixel lows[MAX_STREAMS], highs[MAX_STREAMS];
+                uint8_t thresholds[MAX_STREAMS];
+                for (size_t s = 0; s < count; ++s)
+                {
+                    size_t hist[binaryzation::OTSU_HIST_SIZE] = {0};
+                    for (size_t band = 0; band < pool_.threads(); ++band)
+                    {
+                        const size_t *part = &hist_[(s * pool_.threads() + band) * binaryzation::OTSU_HIST_SIZE];
+                        for (size_t i = 0; i < binaryzation::OTSU_HIST_SIZE; ++i)
+                            hist[i] += part[i];
+                    }
+                    thresholds[s] = binaryzation::otsu_threshold(hist, WIDTH * HEIGHT);
+                    lows[s] = GrayscalePixel{thresholds[s]};
+                    highs[s] = GrayscalePixel::max();
+                }
+                threshold_(src, dst, count, lows, highs, false, results != nullptr);
+                collect_(count, results, thresholds);
+                return true;
+            }
+
+        private:
+            // fn(stream, band, y0, y1)：每个任务处理一路的行 [y0, y1)，每个任务只经过一次线程池的分发
+            template <typename Fn>
+            void for_bands_(size_t count, Fn &&fn)
+            {
+                const size_t threads = pool_.threads();
+                const size_t bands = count < threads ? threads / count : 1;
+                const size_t band_rows = ((HEIGHT + bands - 1) / bands + 7) & ~size_t(7);
+                pool_.run(count * bands, [&](size_t task)
+                          {
+                              const size_t s = task % count, band = task / count;
+                              const size_t y0 = band * band_rows;
+                              const size_t y1 = y0 + band_rows < HEIGHT ? y0 + band_rows : HEIGHT;
+                              if (y0 < y1)
+                                  fn(s, band, y0, y1); });
+            }
+
+            // 打包位中 1 的个数，按 64 位字计数
+            static size_t popcount_(const uint8_t *bits, size_t bytes)
+            {
+                size_t n = 0, i = 0;
+                for (; i + 8 <= bytes; i += 8)
+                {
+                    uint64_t w;
+                    std::memcpy(&w, bits + i, 8);
+                    n += static_cast<size_t>(__builtin_popcountll(w));
+                }
+                for (; i < bytes; ++i)
+                    n += static_cast<size_t>(__builtin_popcount(bits[i]));
+                return n;
+            }
+
+            // shared 为真时所有路使用 t_low[0]、t_high[0]；count_foreground 为假时不统计前景像素数
+            template <PixelFormat PF, typename TPFT>
+            void threshold_(const Image<PF, WIDTH, HEIGHT> *const src[], Image<PixelFormat::Binary, WIDTH, HEIGHT> *const dst[],
+                            size_t count, const TPFT *t_low, const TPFT *t_high, bool shared, bool count_foreground)
+            {
+                std::fill(foreground_.begin(), foreground_.end(), 0);
+                for_bands_(count, [&](size_t s, size_t band, size_t y0, size_t y1)
+                           {
+                               const TPFT lo = t_low[shared ? 0 : s], hi = t_high[shared ? 0 : s];
+                               uint8_t *data = static_cast<uint8_t *>(dst[s]->get_data_ptr());
+                               uint8_t scratch[stream::row_bytes<WIDTH>()];
+                               size_t n = 0;
+                               for (size_t y = y0; y < y1; ++y)
+                               {
+                                   // 宽度是 8 的倍数时每行从字节边界开始，直接写进掩码
+                                   uint8_t *bits = WIDTH % 8 == 0 ? data + y * (WIDTH / 8) : scratch;
+                                   binaryzation::threshold_row_(*src[s], y, bits, lo, hi);
+                                   if constexpr (WIDTH % 8 != 0)
+                                   {
+                                       stream::store_row(*dst[s], y, bits);
+                                       if (count_foreground)
+                                           n += popcount_(bits, stream::row_bytes<WIDTH>());
+                                   }
+                               }
+                               // 整个带的打包位是连续的，一次数完
+                               if (WIDTH % 8 == 0 && count_foreground)
+                                   n = popcount_(data + y0 * (WIDTH / 8), (y1 - y0) * (WIDTH / 8));
+                               foreground_[s * pool_.threads() + band] = n; });
+            }
+
+            void collect_(size_t count, StreamResult results[], const uint8_t *thresholds) const
+            {
+                if (!results)
+                    return;
+                for (size_t s = 0; s < count; ++s)
+                {
+                    size_t n = 0;
+                    for (size_t band = 0; band < pool_.threads(); ++band)
+                        n += foreground_[s * pool_.threads() + band];
+                    results[s] = StreamResult{thresholds ? thresholds[s] : uint8_t(0), n};
+                }
+            }
+
+            WorkerPool pool_;
+            // 每路每个行带一份，合并后得到整帧的结果
+            std::vector<size_t> hist_;
+            std::vector<size_t> foreground_;
+        };
+
+    }
+}
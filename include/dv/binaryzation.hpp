@@ -1,5 +1,14 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "dv/image.hpp"
 
 namespace dv
@@ -21,7 +30,7 @@ namespace dv
                 {
                     TPFT pixel;
                     pixel_cast(src(x, y), pixel);
-                    if (pixel >= t_low && pixel <= t_high)
+                    if (in_range(pixel, t_low, t_high))
                         dst(x, y) = BinaryPixel{255};
                     else
                         dst(x, y) = BinaryPixel{0};
@@ -29,6 +38,129 @@ namespace dv
             }
         }
 
+        // RGB565 的通道在 uint16_t 中的位置取决于编译器的位域布局，这里从实际布局推出
+        // 每个通道最高位组成的掩码（三个通道正好铺满 16 位）
+        inline uint16_t rgb565_field_tops_()
+        {
+            uint16_t tops = 0;
+            const RGB565Pixel fields[3] = {RGB565Pixel{31, 0, 0}, RGB565Pixel{0, 63, 0}, RGB565Pixel{0, 0, 31}};
+            for (const auto &field : fields)
+            {
+                uint16_t m;
+                std::memcpy(&m, &field, sizeof(m));
+                while (m & (m - 1))
+                    m &= static_cast<uint16_t>(m - 1);
+                tops |= m;
+            }
+            return tops;
+        }
+
+        // 打包字内逐通道比较 x >= y，结果在每个通道的最高位（h）上。
+        // 先置位 x 的最高位再减去去掉最高位的 y，借位不会越过通道边界，
+        // 差的最高位即低位部分的比较结果，再与最高位本身合并。
+        inline uint64_t swar_ge_(uint64_t x, uint64_t y, uint64_t h)
+        {
+            uint64_t low = (x | h) - (y & ~h);
+            return ((x & ~y) | (~(x ^ y) & low)) & h;
+        }
+
+        // 4 个像素（每 16 位一个）三个通道都在范围内时，返回低 4 位的通过标志
+        inline uint8_t swar_rgb565_pass4_(uint64_t x, uint64_t lo, uint64_t hi, uint64_t h)
+        {
+            constexpr uint64_t LOW15 = 0x7FFF7FFF7FFF7FFFull;
+            uint64_t diff = (swar_ge_(x, lo, h) & swar_ge_(hi, x, h)) ^ h;  // 通过的像素为 0
+            uint64_t fail = ((diff & LOW15) + LOW15) | diff;                    // 非 0 的像素第 15 位为 1
+            uint64_t pass = (~fail >> 15) & 0x0001000100010001ull;
+            // 把第 0/16/32/48 位的标志收集到第 48~51 位，交叉项都落在 48 位以下或溢出
+            return static_cast<uint8_t>((pass * 0x0001000200040008ull) >> 48 & 0xF);
+        }
+
+        // RGB565 按 uint16_t 整字做三通道区间判定，N 个像素直接写成打包位（bits 从字节边界开始）
+        inline void rgb565_range_mask_(const uint16_t *in, size_t N, RGB565Pixel t_low, RGB565Pixel t_high, uint8_t *bits)
+        {
+            static const uint16_t tops = rgb565_field_tops_();
+            uint16_t lo16, hi16;
+            std::memcpy(&lo16, &t_low, sizeof(lo16));
+            std::memcpy(&hi16, &t_high, sizeof(hi16));
+
+            size_t i = 0;
+#if defined(__SSE2__)
+            const __m128i h = _mm_set1_epi16(static_cast<short>(tops));
+            const __m128i lo = _mm_set1_epi16(static_cast<short>(lo16));
+            const __m128i hi = _mm_set1_epi16(static_cast<short>(hi16));
+            const __m128i lo_low = _mm_andnot_si128(h, lo);
+            auto pass8 = [&](__m128i x)
+            {
+                __m128i ge_lo = _mm_or_si128(_mm_andnot_si128(lo, x),
+                                             _mm_andnot_si128(_mm_xor_si128(x, lo), _mm_sub_epi16(_mm_or_si128(x, h), lo_low)));
+                __m128i ge_hi = _mm_or_si128(_mm_andnot_si128(x, hi),
+                                             _mm_andnot_si128(_mm_xor_si128(x, hi),
+                                                              _mm_sub_epi16(_mm_or_si128(hi, h), _mm_andnot_si128(h, x))));
+                return _mm_cmpeq_epi16(_mm_and_si128(_mm_and_si128(ge_lo, ge_hi), h), h);
+            };
+            for (; i + 16 <= N; i += 16)
+            {
+                __m128i m0 = pass8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)));
+                __m128i m1 = pass8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 8)));
+                uint16_t word = static_cast<uint16_t>(_mm_movemask_epi8(_mm_packs_epi16(m0, m1)));
+                std::memcpy(bits + i / 8, &word, 2);
+            }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+            const uint16x8_t h = vdupq_n_u16(tops);
+            const uint16x8_t lo = vdupq_n_u16(lo16);
+            const uint16x8_t hi = vdupq_n_u16(hi16);
+            static const uint8_t weights_data[8] = {1, 2, 4, 8, 16, 32, 64, 128};
+            const uint8x8_t weights = vld1_u8(weights_data);
+            for (; i + 8 <= N; i += 8)
+            {
+                uint16x8_t x = vld1q_u16(in + i);
+                uint16x8_t ge_lo = vorrq_u16(vbicq_u16(x, lo),
+                                             vbicq_u16(vsubq_u16(vorrq_u16(x, h), vbicq_u16(lo, h)), veorq_u16(x, lo)));
+                uint16x8_t ge_hi = vorrq_u16(vbicq_u16(hi, x),
+                                             vbicq_u16(vsubq_u16(vorrq_u16(hi, h), vbicq_u16(x, h)), veorq_u16(x, hi)));
+                uint8x8_t m = vmovn_u16(vceqq_u16(vandq_u16(vandq_u16(ge_lo, ge_hi), h), h));
+                bits[i / 8] = vaddv_u8(vand_u8(m, weights));
+            }
+#else
+            const uint64_t h = tops * 0x0001000100010001ull;
+            const uint64_t lo = lo16 * 0x0001000100010001ull;
+            const uint64_t hi = hi16 * 0x0001000100010001ull;
+            for (const size_t body = N / 8 * 8; i < body; i += 8)
+            {
+                uint64_t w0, w1;
+                std::memcpy(&w0, in + i, 8);
+                std::memcpy(&w1, in + i + 4, 8);
+                bits[i / 8] = static_cast<uint8_t>(swar_rgb565_pass4_(w0, lo, hi, h) |
+                                                   swar_rgb565_pass4_(w1, lo, hi, h) << 4);
+            }
+#endif
+            // 尾部逐像素；i 此时总是 8 的倍数
+            uint8_t acc = 0;
+            for (; i < N; ++i)
+            {
+                RGB565Pixel pixel;
+                std::memcpy(&pixel, in + i, sizeof(pixel));
+                acc |= static_cast<uint8_t>(in_range(pixel, t_low, t_high) << (i % 8));
+                if (i % 8 == 7)
+                {
+                    bits[i / 8] = acc;
+                    acc = 0;
+                }
+            }
+            if (N % 8)
+                bits[N / 8] = acc;
+        }
+
+        template <size_t WIDTH, size_t HEIGHT>
+        inline void threshold(const Image<PixelFormat::RGB565, WIDTH, HEIGHT> &src,
+                       Image<PixelFormat::Binary, WIDTH, HEIGHT> &dst,
+                       RGB565Pixel t_low,
+                       RGB565Pixel t_high)
+        {
+            rgb565_range_mask_(static_cast<const uint16_t *>(src.get_data_ptr()), WIDTH * HEIGHT, t_low, t_high,
+                               static_cast<uint8_t *>(dst.get_data_ptr()));
+        }
+
         template <PixelFormat PF, typename TPFT, size_t WIDTH, size_t HEIGHT>
         inline void threshold(const Image<PF, WIDTH, HEIGHT> &src,
                        Image<PixelFormat::Binary, WIDTH, HEIGHT> &dst,
@@ -38,32 +170,33 @@ namespace dv
             threshold(src, dst, t, t_max);
         }
 
+        // YUV422 直接在色度上阈值化：每两个像素共享一组 U/V，不需要先转换成 RGB565/LAB
         template <size_t WIDTH, size_t HEIGHT>
-        inline void otsu(const Image<PixelFormat::Grayscale, WIDTH, HEIGHT> &src,
-                  Image<PixelFormat::Binary, WIDTH, HEIGHT> &dst)
+        inline void threshold(const Image<PixelFormat::YUV422, WIDTH, HEIGHT> &src,
+                       Image<PixelFormat::Binary, WIDTH, HEIGHT> &dst,
+                       YUVPixel t_low,
+                       YUVPixel t_high)
         {
-            // histogram
-            constexpr size_t HIST_SIZE = 256;
-            size_t hist[HIST_SIZE] = {0};
+            static_assert(WIDTH % 2 == 0, "YUV422 width must be even");
             for (size_t y = 0; y < HEIGHT; ++y)
             {
-                for (size_t x = 0; x < WIDTH; ++x)
+                for (size_t x = 0; x < WIDTH; x += 2)
                 {
-                    auto pixel = src(x, y);
-                    size_t idx = static_cast<size_t>(pixel);
-                    if (idx >= HIST_SIZE)
-                    {
-                        idx = HIST_SIZE - 1;
-                    }
-                    hist[idx]++;
+                    const YUV422Pixel &p0 = src(x, y);
+                    const YUV422Pixel &p1 = src(x + 1, y);
+                    bool chroma = p0.c >= t_low.u && p0.c <= t_high.u && p1.c >= t_low.v && p1.c <= t_high.v;
+                    dst(x, y) = (chroma && p0.y >= t_low.y && p0.y <= t_high.y) ? BinaryPixel{255} : BinaryPixel{0};
+                    dst(x + 1, y) = (chroma && p1.y >= t_low.y && p1.y <= t_high.y) ? BinaryPixel{255} : BinaryPixel{0};
                 }
             }
+        }
 
-            // total number of pixels
-            size_t total = WIDTH * HEIGHT;
+        constexpr size_t OTSU_HIST_SIZE = 256;
 
+        inline uint8_t otsu_threshold_float(const size_t hist[OTSU_HIST_SIZE], size_t total)
+        {
             float sum = 0;
-            for (size_t t = 0; t < HIST_SIZE; ++t)
+            for (size_t t = 0; t < OTSU_HIST_SIZE; ++t)
             {
                 sum += t * hist[t];
             }
@@ -75,7 +208,7 @@ namespace dv
             float varMax = 0;
             size_t threshold = 0;
 
-            for (size_t t = 0; t < HIST_SIZE; ++t)
+            for (size_t t = 0; t < OTSU_HIST_SIZE; ++t)
             {
                 wB += hist[t];
                 if (wB == 0)
@@ -97,8 +230,321 @@ namespace dv
                     threshold = t;
                 }
             }
+            return static_cast<uint8_t>(threshold);
+        }
+
+        // 64 x 64 -> 128 位无符号乘法，只用 32 位乘法（32 位 MCU 上没有 __int128）
+        inline void mul_u64_(uint64_t a, uint64_t b, uint64_t &hi, uint64_t &lo)
+        {
+            const uint64_t a0 = a & 0xFFFFFFFF, a1 = a >> 32;
+            const uint64_t b0 = b & 0xFFFFFFFF, b1 = b >> 32;
+            const uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+            const uint64_t mid = (p00 >> 32) + (p01 & 0xFFFFFFFF) + (p10 & 0xFFFFFFFF);
+            lo = (mid << 32) | (p00 & 0xFFFFFFFF);
+            hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+        }
+
+        // num^2 * d，结果须小于 2^128
+        inline void square_mul_(uint64_t num, uint64_t d, uint64_t &hi, uint64_t &lo)
+        {
+            uint64_t sq_hi, sq_lo, h;
+            mul_u64_(num, num, sq_hi, sq_lo);
+            mul_u64_(sq_lo, d, h, lo);
+            hi = h + sq_hi * d;
+        }
+
+        // 纯整数 Otsu：类间方差 wB * wF * (mB - mF)^2 = num^2 / (wB * wF)，
+        // 其中 num = total * sumB - wB * sum。交叉相乘比较分数，没有除法和舍入，
+        // 像素总数不超过 2^19（如 640x480）时不会溢出。
+        inline uint8_t otsu_threshold_fixed(const size_t hist[OTSU_HIST_SIZE], size_t total)
+        {
+            uint64_t sum = 0;
+            for (size_t t = 0; t < OTSU_HIST_SIZE; ++t)
+            {
+                sum += uint64_t(t) * hist[t];
+            }
+
+            uint64_t sumB = 0;
+            uint64_t wB = 0;
+            uint64_t best_num = 0;
+            uint64_t best_den = 1;
+            size_t threshold = 0;
+
+            for (size_t t = 0; t < OTSU_HIST_SIZE; ++t)
+            {
+                wB += hist[t];
+                if (wB == 0)
+                    continue;
+                const uint64_t wF = total - wB;
+                if (wF == 0)
+                    break;
+
+                sumB += uint64_t(t) * hist[t];
+
+                const uint64_t a = uint64_t(total) * sumB, b = wB * sum;
+                const uint64_t num = a > b ? a - b : b - a;
+                const uint64_t den = wB * wF;
+
+                // num^2 / den > best_num^2 / best_den
+                uint64_t l_hi, l_lo, r_hi, r_lo;
+                square_mul_(num, best_den, l_hi, l_lo);
+                square_mul_(best_num, den, r_hi, r_lo);
+                if (l_hi > r_hi || (l_hi == r_hi && l_lo > r_lo))
+                {
+                    best_num = num;
+                    best_den = den;
+                    threshold = t;
+                }
+            }
+            return static_cast<uint8_t>(threshold);
+        }
+
+        // 根据灰度直方图求 Otsu 阈值，整帧和逐行流式处理共用。
+        // 定义 DV_INTEGER_ONLY 时使用纯整数版本
+        inline uint8_t otsu_threshold(const size_t hist[OTSU_HIST_SIZE], size_t total)
+        {
+#if defined(DV_INTEGER_ONLY)
+            return otsu_threshold_fixed(hist, total);
+#else
+            return otsu_threshold_float(hist, total);
+#endif
+        }
+
+        template <size_t WIDTH, size_t HEIGHT>
+        inline void otsu(const Image<PixelFormat::Grayscale, WIDTH, HEIGHT> &src,
+                  Image<PixelFormat::Binary, WIDTH, HEIGHT> &dst)
+        {
+            // histogram
+            size_t hist[OTSU_HIST_SIZE] = {0};
+            for (size_t y = 0; y < HEIGHT; ++y)
+            {
+                for (size_t x = 0; x < WIDTH; ++x)
+                {
+                    auto pixel = src(x, y);
+                    size_t idx = static_cast<size_t>(pixel);
+                    if (idx >= OTSU_HIST_SIZE)
+                    {
+                        idx = OTSU_HIST_SIZE - 1;
+                    }
+                    hist[idx]++;
+                }
+            }
+
+            uint8_t threshold = otsu_threshold(hist, WIDTH * HEIGHT);
+            binaryzation::threshold(src, dst, GrayscalePixel{threshold});
+        }
 
-            binaryzation::threshold(src, dst, GrayscalePixel{static_cast<uint8_t>(threshold)});
+        // 二值图的一行打包位（bit i 对应第 i 个像素）。宽度是 8 的倍数时直接指向图像数据，
+        // 否则行不从字节边界开始，拼到 scratch（至少 (WIDTH + 7) / 8 字节）中
+        template <size_t WIDTH, size_t HEIGHT, typename Derived>
+        inline const uint8_t *row_bits(const ImageBase<PixelFormat::Binary, WIDTH, HEIGHT, Derived> &img, size_t y, uint8_t *scratch)
+        {
+            const uint8_t *data = static_cast<const uint8_t *>(img.get_data_ptr());
+            if constexpr (WIDTH % 8 == 0)
+            {
+                return data + y * (WIDTH / 8);
+            }
+            else
+            {
+                constexpr size_t BYTES = (WIDTH * HEIGHT + 7) / 8;
+                for (size_t i = 0; i < (WIDTH + 7) / 8; ++i)
+                {
+                    size_t bit = y * WIDTH + 8 * i;
+                    size_t byte = bit / 8;
+                    uint16_t v = static_cast<uint16_t>(data[byte] | (byte + 1 < BYTES ? data[byte + 1] << 8 : 0));
+                    scratch[i] = static_cast<uint8_t>(v >> (bit % 8));
+                }
+                scratch[WIDTH / 8] &= static_cast<uint8_t>((1u << (WIDTH % 8)) - 1);
+                return scratch;
+            }
+        }
+
+        // 二值图的占用图：每个 8x8 块一位（第 0 层），每个块行再一位（第 1 层）。
+        // 打包行的第 i 个字节正好是第 i 个块的一行，所以只需判断字节是否非零。
+        // 阈值化输出时顺带生成（或流式处理时每行 mark_row），后续的连通域等只遍历非空块。
+        template <size_t WIDTH, size_t HEIGHT>
+        class OccupancyMap
+        {
+        public:
+            static constexpr size_t TILE = 8;
+            static constexpr size_t TILES_X = (WIDTH + TILE - 1) / TILE;
+            static constexpr size_t TILES_Y = (HEIGHT + TILE - 1) / TILE;
+            static constexpr size_t WORDS = (TILES_X + 63) / 64;
+
+            void clear()
+            {
+                std::memset(tiles_, 0, sizeof(tiles_));
+                std::memset(rows_, 0, sizeof(rows_));
+            }
+
+            // bits: 第 y 行的打包位，(WIDTH + 7) / 8 字节，与 stream::threshold_row 的输出相同
+            void mark_row(size_t y, const uint8_t *bits)
+            {
+                const size_t ty = y / TILE;
+                uint64_t any = 0;
+                for (size_t i = 0; i < TILES_X; i += 8)
+                {
+                    uint64_t w = 0;
+                    std::memcpy(&w, bits + i, TILES_X - i < 8 ? TILES_X - i : 8);
+                    // 每个非零字节的最高位置 1，再把 8 个最高位收集到低 8 位
+                    uint64_t nz = (((w & 0x7F7F7F7F7F7F7F7Full) + 0x7F7F7F7F7F7F7F7Full) | w) & 0x8080808080808080ull;
+                    uint64_t mask = ((nz >> 7) * 0x0102040810204080ull) >> 56;
+                    tiles_[ty][i / 64] |= mask << (i % 64);
+                    any |= mask;
+                }
+                if (any)
+                    rows_[ty / 64] |= uint64_t(1) << (ty % 64);
+            }
+
+            template <typename Derived>
+            void build(const ImageBase<PixelFormat::Binary, WIDTH, HEIGHT, Derived> &img)
+            {
+                clear();
+                uint8_t scratch[TILES_X];
+                for (size_t y = 0; y < HEIGHT; ++y)
+                {
+                    mark_row(y, row_bits(img, y, scratch));
+                }
+            }
+
+            bool occupied(size_t tx, size_t ty) const
+            {
+                return (tiles_[ty][tx / 64] >> (tx % 64)) & 1;
+            }
+
+            bool row_occupied(size_t ty) const
+            {
+                return (rows_[ty / 64] >> (ty % 64)) & 1;
+            }
+
+            // 第 ty 个块行的位图，WORDS 个 uint64_t
+            const uint64_t *tile_row(size_t ty) const { return tiles_[ty]; }
+
+            size_t count() const
+            {
+                size_t n = 0;
+                for (size_t ty = 0; ty < TILES_Y; ++ty)
+                {
+                    for (size_t i = 0; i < WORDS; ++i)
+                        n += static_cast<size_t>(__builtin_popcountll(tiles_[ty][i]));
+                }
+                return n;
+            }
+
+            // 按行优先顺序对每个非空块调用 fn(tx, ty)，空的块行由第 1 层直接跳过
+            template <typename Fn>
+            void for_each_tile(Fn fn) const
+            {
+                for (size_t r = 0; r < (TILES_Y + 63) / 64; ++r)
+                {
+                    for (uint64_t rows = rows_[r]; rows; rows &= rows - 1)
+                    {
+                        size_t ty = r * 64 + static_cast<size_t>(__builtin_ctzll(rows));
+                        for (size_t i = 0; i < WORDS; ++i)
+                        {
+                            for (uint64_t w = tiles_[ty][i]; w; w &= w - 1)
+                            {
+                                fn(i * 64 + static_cast<size_t>(__builtin_ctzll(w)), ty);
+                            }
+                        }
+                    }
+                }
+            }
+
+        private:
+            uint64_t tiles_[TILES_Y][WORDS] = {};
+            uint64_t rows_[(TILES_Y + 63) / 64] = {};
+        };
+
+        // 单行阈值化成打包位（bit x 对应第 x 个像素，bits 从字节边界开始），判定与整帧的 threshold 相同
+        template <PixelFormat PF, typename TPFT, size_t WIDTH, size_t HEIGHT>
+        inline void threshold_row_(const Image<PF, WIDTH, HEIGHT> &src, size_t y, uint8_t *bits, TPFT t_low, TPFT t_high)
+        {
+            uint8_t acc = 0;
+            for (size_t x = 0; x < WIDTH; ++x)
+            {
+                TPFT pixel;
+                pixel_cast(src(x, y), pixel);
+                acc |= static_cast<uint8_t>(in_range(pixel, t_low, t_high) << (x % 8));
+                if (x % 8 == 7)
+                {
+                    bits[x / 8] = acc;
+                    acc = 0;
+                }
+            }
+            if (WIDTH % 8)
+                bits[WIDTH / 8] = acc;
+        }
+
+        template <size_t WIDTH, size_t HEIGHT>
+        inline void threshold_row_(const Image<PixelFormat::RGB565, WIDTH, HEIGHT> &src, size_t y, uint8_t *bits,
+                                   RGB565Pixel t_low, RGB565Pixel t_high)
+        {
+            rgb565_range_mask_(static_cast<const uint16_t *>(src.get_data_ptr()) + y * WIDTH, WIDTH, t_low, t_high, bits);
+        }
+
+        template <size_t WIDTH, size_t HEIGHT>
+        inline void threshold_row_(const Image<PixelFormat::YUV422, WIDTH, HEIGHT> &src, size_t y, uint8_t *bits,
+                                   YUVPixel t_low, YUVPixel t_high)
+        {
+            static_assert(WIDTH % 2 == 0, "YUV422 width must be even");
+            std::memset(bits, 0, (WIDTH + 7) / 8);
+            for (size_t x = 0; x < WIDTH; x += 2)
+            {
+                const YUV422Pixel &p0 = src(x, y);
+                const YUV422Pixel &p1 = src(x + 1, y);
+                bool chroma = p0.c >= t_low.u && p0.c <= t_high.u && p1.c >= t_low.v && p1.c <= t_high.v;
+                bits[x / 8] |= static_cast<uint8_t>((chroma && p0.y >= t_low.y && p0.y <= t_high.y) << (x % 8));
+                bits[x / 8] |= static_cast<uint8_t>((chroma && p1.y >= t_low.y && p1.y <= t_high.y) << (x % 8 + 1));
+            }
+        }
+
+        // 阈值化的同时生成占用图：逐行写出打包位，趁这一行还在缓存里立即 mark_row，不再整帧扫第二遍。
+        // 宽度是 8 的倍数时直接写进 dst 的行，否则先写到行缓冲再拼进 dst
+        template <typename SrcImage, typename TPFT, size_t WIDTH, size_t HEIGHT>
+        inline void threshold(const SrcImage &src,
+                              Image<PixelFormat::Binary, WIDTH, HEIGHT> &dst,
+                              TPFT t_low,
+                              TPFT t_high,
+                              OccupancyMap<WIDTH, HEIGHT> &occupancy)
+        {
+            occupancy.clear();
+            uint8_t *data = static_cast<uint8_t *>(dst.get_data_ptr());
+            for (size_t y = 0; y < HEIGHT; ++y)
+            {
+                if constexpr (WIDTH % 8 == 0)
+                {
+                    uint8_t *bits = data + y * (WIDTH / 8);
+                    threshold_row_(src, y, bits, t_low, t_high);
+                    occupancy.mark_row(y, bits);
+                }
+                else
+                {
+                    uint8_t scratch[(WIDTH + 7) / 8];
+                    threshold_row_(src, y, scratch, t_low, t_high);
+                    for (size_t x = 0; x < WIDTH; ++x)
+                        dst(x, y) = ((scratch[x / 8] >> (x % 8)) & 1) ? BinaryPixel{255} : BinaryPixel{0};
+                    occupancy.mark_row(y, scratch);
+                }
+            }
+        }
+
+        template <size_t WIDTH, size_t HEIGHT>
+        inline void otsu(const Image<PixelFormat::Grayscale, WIDTH, HEIGHT> &src,
+                         Image<PixelFormat::Binary, WIDTH, HEIGHT> &dst,
+                         OccupancyMap<WIDTH, HEIGHT> &occupancy)
+        {
+            size_t hist[OTSU_HIST_SIZE] = {0};
+            for (size_t y = 0; y < HEIGHT; ++y)
+            {
+                for (size_t x = 0; x < WIDTH; ++x)
+                {
+                    auto pixel = src(x, y);
+                    hist[static_cast<size_t>(pixel)]++;
+                }
+            }
+            GrayscalePixel t{otsu_threshold(hist, WIDTH * HEIGHT)};
+            threshold(src, dst, t, t.max(), occupancy);
         }
 
         
@@ -0,0 +1,396 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include "dv/image.hpp"
+
+namespace dv
+{
+    namespace codec
+    {
+        using namespace image;
+        using namespace pixel_format;
+
+        struct CodecStats
+        {
+            size_t frames = 0;
+            size_t raw_bytes = 0;
+            size_t encoded_bytes = 0;
+
+            void record(size_t raw, size_t encoded)
+            {
+                frames++;
+                raw_bytes += raw;
+                encoded_bytes += encoded;
+            }
+
+            size_t bytes_per_frame() const
+            {
+                return frames ? encoded_bytes / frames : 0;
+            }
+
+            float ratio() const
+            {
+                return encoded_bytes ? static_cast<float>(raw_bytes) / encoded_bytes : 0.0f;
+            }
+        };
+
+        inline size_t put_varint(uint8_t *out, uint32_t v)
+        {
+            size_t n = 0;
+            while (v >= 0x80)
+            {
+                out[n++] = static_cast<uint8_t>(v | 0x80);
+                v >>= 7;
+            }
+            out[n++] = static_cast<uint8_t>(v);
+            return n;
+        }
+
+        inline bool get_varint(const uint8_t *&p, const uint8_t *end, uint32_t &v)
+        {
+            v = 0;
+            for (int shift = 0; shift < 35 && p < end; shift += 7)
+            {
+                uint8_t byte = *p++;
+                v |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                    return true;
+            }
+            return false;
+        }
+
+        // 多字节字段一律按大端写入，与 img.bin 的 RGB565 字节序相同，编码结果与主机字节序无关
+        inline void put_be16(uint8_t *out, uint16_t v)
+        {
+            out[0] = static_cast<uint8_t>(v >> 8);
+            out[1] = static_cast<uint8_t>(v);
+        }
+
+        inline void put_be32(uint8_t *out, uint32_t v)
+        {
+            out[0] = static_cast<uint8_t>(v >> 24);
+            out[1] = static_cast<uint8_t>(v >> 16);
+            out[2] = static_cast<uint8_t>(v >> 8);
+            out[3] = static_cast<uint8_t>(v);
+        }
+
+        inline uint16_t get_be16(const uint8_t *in)
+        {
+            return static_cast<uint16_t>((in[0] << 8) | in[1]);
+        }
+
+        inline uint32_t get_be32(const uint8_t *in)
+        {
+            return (static_cast<uint32_t>(in[0]) << 24) | (static_cast<uint32_t>(in[1]) << 16) |
+                   (static_cast<uint32_t>(in[2]) << 8) | in[3];
+        }
+
+        // ---------------------------------------------------------------------
+        // 二值掩码的游程编码
+        //
+        // 第一个字节是模式：MASK_RLE 后面是交替的 0/1 游程长度（从 0 游程开始，
+        // LEB128 变长整数）；如果游程编码比原始数据还大，则退化为 MASK_RAW，
+        // 后面直接跟 Image<Binary> 的打包位数据。
+        // ---------------------------------------------------------------------
+        enum MaskMode : uint8_t
+        {
+            MASK_RLE = 0,
+            MASK_RAW = 1,
+        };
+
+        template <size_t WIDTH, size_t HEIGHT>
+        constexpr size_t mask_max_encoded_size()
+        {
+            return 1 + (WIDTH * HEIGHT + 7) / 8;
+        }
+
+        // 返回编码后的字节数；capacity 不少于 mask_max_encoded_size() 时总能成功，否则可能返回 0
+        template <size_t WIDTH, size_t HEIGHT, typename Derived>
+        inline size_t mask_encode(const ImageBase<PixelFormat::Binary, WIDTH, HEIGHT, Derived> &src,
+                                  uint8_t *out, size_t capacity)
+        {
+            constexpr size_t BIT_COUNT = WIDTH * HEIGHT;
+            constexpr size_t BYTE_COUNT = (BIT_COUNT + 7) / 8;
+            constexpr size_t RAW_SIZE = 1 + BYTE_COUNT;
+            if (capacity == 0)
+                return 0;
+
+            const uint8_t *bytes = static_cast<const uint8_t *>(src.get_data_ptr());
+            // 游程编码超过这个长度就直接输出原始数据
+            const size_t limit = capacity < RAW_SIZE ? capacity : RAW_SIZE;
+
+            size_t n = 1;
+            out[0] = MASK_RLE;
+            uint64_t cur = 0; // 当前游程的取值，0 或全 1
+            size_t run_start = 0;
+            bool overflow = false;
+
+            for (size_t base = 0; base < BIT_COUNT && !overflow; base += 64)
+            {
+                uint64_t w = 0;
+                size_t byte_off = base / 8;
+                std::memcpy(&w, bytes + byte_off, BYTE_COUNT - byte_off < 8 ? BYTE_COUNT - byte_off : 8);
+                size_t valid = BIT_COUNT - base < 64 ? BIT_COUNT - base : 64;
+
+                // 与当前游程取值不同的位就是游程的边界
+                uint64_t diff = w ^ cur;
+                if (valid < 64)
+                    diff &= (uint64_t(1) << valid) - 1;
+                while (diff)
+                {
+                    unsigned t = static_cast<unsigned>(__builtin_ctzll(diff));
+                    size_t pos = base + t;
+                    if (n + 5 > limit)
+                    {
+                        overflow = true;
+                        break;
+                    }
+                    n += put_varint(out + n, static_cast<uint32_t>(pos - run_start));
+                    run_start = pos;
+                    cur = ~cur;
+                    diff = (w ^ cur) & (~uint64_t(0) << t);
+                    if (valid < 64)
+                        diff &= (uint64_t(1) << valid) - 1;
+                }
+            }
+
+            if (!overflow && n + 5 <= limit)
+            {
+                n += put_varint(out + n, static_cast<uint32_t>(BIT_COUNT - run_start));
+                return n;
+            }
+
+            if (capacity < RAW_SIZE)
+                return 0;
+            out[0] = MASK_RAW;
+            std::memcpy(out + 1, bytes, BYTE_COUNT);
+            if (BIT_COUNT % 8)
+                out[BYTE_COUNT] &= static_cast<uint8_t>((1u << (BIT_COUNT % 8)) - 1);
+            return RAW_SIZE;
+        }
+
+        inline void set_bit_range_(uint8_t *bytes, size_t begin, size_t end)
+        {
+            if (begin >= end)
+                return;
+            size_t b0 = begin / 8;
+            size_t b1 = (end - 1) / 8;
+            uint8_t head = static_cast<uint8_t>(0xFFu << (begin % 8));
+            uint8_t tail = static_cast<uint8_t>(0xFFu >> (7 - (end - 1) % 8));
+            if (b0 == b1)
+            {
+                bytes[b0] |= head & tail;
+                return;
+            }
+            bytes[b0] |= head;
+            if (b1 > b0 + 1)
+                std::memset(bytes + b0 + 1, 0xFF, b1 - b0 - 1);
+            bytes[b1] |= tail;
+        }
+
+        template <size_t WIDTH, size_t HEIGHT, typename Derived>
+        inline bool mask_decode(const uint8_t *in, size_t size,
+                                ImageBase<PixelFormat::Binary, WIDTH, HEIGHT, Derived> &dst)
+        {
+            constexpr size_t BIT_COUNT = WIDTH * HEIGHT;
+            constexpr size_t BYTE_COUNT = (BIT_COUNT + 7) / 8;
+            if (size == 0)
+                return false;
+
+            uint8_t *bytes = static_cast<uint8_t *>(dst.get_data_ptr());
+            if (in[0] == MASK_RAW)
+            {
+                if (size != 1 + BYTE_COUNT)
+                    return false;
+                std::memcpy(bytes, in + 1, BYTE_COUNT);
+                return true;
+            }
+            if (in[0] != MASK_RLE)
+                return false;
+
+            std::memset(bytes, 0, BYTE_COUNT);
+            const uint8_t *p = in + 1;
+            const uint8_t *end = in + size;
+            size_t pos = 0;
+            bool ones = false;
+            while (p < end)
+            {
+                uint32_t run;
+                if (!get_varint(p, end, run) || run > BIT_COUNT - pos)
+                    return false;
+                if (ones)
+                    set_bit_range_(bytes, pos, pos + run);
+                pos += run;
+                ones = !ones;
+            }
+            return pos == BIT_COUNT;
+        }
+
+        // ---------------------------------------------------------------------
+        // RGB565 序列的帧间差分编码（无损）
+        //
+        // 关键帧：FRAME_KEY，后面是与 img.bin 相同的大端 RGB565 原始数据，
+        //         解码时直接走 raw_to_rgb565。
+        // 差分帧：FRAME_DELTA，后面是每块一位的跳过标志（块 = 连续 DELTA_BLOCK 个像素），
+        //         对每个变化的块：uint32 像素变化掩码 + 变化像素与上一帧的 XOR 值（均为大端）。
+        // 差分帧比关键帧还大时自动改为关键帧。
+        // ---------------------------------------------------------------------
+        enum FrameType : uint8_t
+        {
+            FRAME_KEY = 0,
+            FRAME_DELTA = 1,
+        };
+
+        constexpr size_t DELTA_BLOCK = 32;
+
+        template <size_t WIDTH, size_t HEIGHT>
+        constexpr size_t delta_max_encoded_size()
+        {
+            return 1 + WIDTH * HEIGHT * 2;
+        }
+
+        template <size_t WIDTH, size_t HEIGHT>
+        class DeltaEncoder
+        {
+        public:
+            explicit DeltaEncoder(size_t key_interval = 300) : key_interval_(key_interval) {}
+
+            // 下一帧强制编码为关键帧（例如开始新的录像文件时）
+            void reset() { frame_index_ = 0; }
+
+            template <typename Derived>
+            size_t encode(const ImageBase<PixelFormat::RGB565, WIDTH, HEIGHT, Derived> &frame,
+                          uint8_t *out, size_t capacity)
+            {
+                constexpr size_t RAW_SIZE = delta_max_encoded_size<WIDTH, HEIGHT>();
+                if (capacity < RAW_SIZE)
+                    return 0;
+
+                const uint16_t *cur = static_cast<const uint16_t *>(frame.get_data_ptr());
+                uint16_t *prev = static_cast<uint16_t *>(prev_.get_data_ptr());
+
+                size_t n = 0;
+                bool key = key_interval_ == 0 ? frame_index_ == 0 : frame_index_ % key_interval_ == 0;
+                if (!key)
+                    n = encode_delta(cur, prev, out, RAW_SIZE);
+                if (n == 0)
+                    n = encode_key(cur, out);
+
+                std::memcpy(prev, cur, PIXELS * 2);
+                frame_index_++;
+                return n;
+            }
+
+        private:
+            static constexpr size_t PIXELS = WIDTH * HEIGHT;
+            static constexpr size_t BLOCKS = (PIXELS + DELTA_BLOCK - 1) / DELTA_BLOCK;
+            static constexpr size_t FLAG_BYTES = (BLOCKS + 7) / 8;
+
+            static size_t encode_key(const uint16_t *cur, uint8_t *out)
+            {
+                out[0] = FRAME_KEY;
+                uint8_t *p = out + 1;
+                for (size_t i = 0; i < PIXELS; ++i)
+                    put_be16(p + 2 * i, cur[i]);
+                return 1 + PIXELS * 2;
+            }
+
+            // 返回 0 表示差分帧不比关键帧小
+            static size_t encode_delta(const uint16_t *cur, const uint16_t *prev, uint8_t *out, size_t limit)
+            {
+                out[0] = FRAME_DELTA;
+                uint8_t *flags = out + 1;
+                std::memset(flags, 0, FLAG_BYTES);
+                size_t n = 1 + FLAG_BYTES;
+
+                for (size_t blk = 0; blk < BLOCKS; ++blk)
+                {
+                    size_t begin = blk * DELTA_BLOCK;
+                    size_t count = PIXELS - begin < DELTA_BLOCK ? PIXELS - begin : DELTA_BLOCK;
+                    if (std::memcmp(cur + begin, prev + begin, count * 2) == 0)
+                        continue;
+                    if (n + 4 + count * 2 >= limit)
+                        return 0;
+
+                    flags[blk / 8] |= static_cast<uint8_t>(1u << (blk % 8));
+                    uint8_t *mask_ptr = out + n;
+                    n += 4;
+                    uint32_t mask = 0;
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        uint16_t x = cur[begin + i] ^ prev[begin + i];
+                        if (x == 0)
+                            continue;
+                        mask |= uint32_t(1) << i;
+                        put_be16(out + n, x);
+                        n += 2;
+                    }
+                    put_be32(mask_ptr, mask);
+                }
+                return n;
+            }
+
+            Image<PixelFormat::RGB565, WIDTH, HEIGHT> prev_;
+            size_t key_interval_;
+            size_t frame_index_ = 0;
+        };
+
+        template <size_t WIDTH, size_t HEIGHT>
+        class DeltaDecoder
+        {
+        public:
+            // dst 必须是上一次 decode 的输出（差分帧在其基础上原地更新）
+            bool decode(const uint8_t *in, size_t size, Image<PixelFormat::RGB565, WIDTH, HEIGHT> &dst)
+            {
+                if (size == 0)
+                    return false;
+                if (in[0] == FRAME_KEY)
+                {
+                    if (size != 1 + PIXELS * 2)
+                        return false;
+                    raw_to_rgb565(in + 1, dst);
+                    has_key_ = true;
+                    return true;
+                }
+                if (in[0] != FRAME_DELTA || !has_key_ || size < 1 + FLAG_BYTES)
+                    return false;
+
+                uint16_t *pix = static_cast<uint16_t *>(dst.get_data_ptr());
+                const uint8_t *flags = in + 1;
+                const uint8_t *p = in + 1 + FLAG_BYTES;
+                const uint8_t *end = in + size;
+                for (size_t blk = 0; blk < BLOCKS; ++blk)
+                {
+                    if (!(flags[blk / 8] & (1u << (blk % 8))))
+                        continue;
+                    if (end - p < 4)
+                        return false;
+                    uint32_t mask = get_be32(p);
+                    p += 4;
+                    uint16_t *block = pix + blk * DELTA_BLOCK;
+                    while (mask)
+                    {
+                        unsigned i = static_cast<unsigned>(__builtin_ctz(mask));
+                        if (end - p < 2 || blk * DELTA_BLOCK + i >= PIXELS)
+                            return false;
+                        block[i] ^= get_be16(p);
+                        p += 2;
+                        mask &= mask - 1;
+                    }
+                }
+                return p == end;
+            }
+
+        private:
+            static constexpr size_t PIXELS = WIDTH * HEIGHT;
+            static constexpr size_t BLOCKS = (PIXELS + DELTA_BLOCK - 1) / DELTA_BLOCK;
+            static constexpr size_t FLAG_BYTES = (BLOCKS + 7) / 8;
+
+            bool has_key_ = false;
+        };
+
+    }
+}
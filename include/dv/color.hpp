@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <array>
+
+#include "dv/image.hpp"
+
+namespace dv
+{
+    namespace color
+    {
+        using namespace image;
+        using namespace pixel_format;
+
+        // 颜色校正：白平衡增益 -> 3x3 颜色矩阵 -> gamma，整个变换烘焙成 65536 项的
+        // RGB565 -> RGB565 重映射表，每个像素只查一次表。
+        // RGB565 字按 LAB 表的约定解释：高 5 位 R，中间 6 位 G，低 5 位 B。
+        //
+        // 参数修改后调用 update() 重建表。重建先按通道算出 32/64 级的定点贡献，
+        // 再做 65536 次整数加法和查表，可以在两帧之间完成。
+        class ColorCorrection
+        {
+        public:
+            ColorCorrection()
+            {
+                update();
+            }
+
+            void set_gains(float r, float g, float b)
+            {
+                gains_[0] = r;
+                gains_[1] = g;
+                gains_[2] = b;
+            }
+
+            // 行优先，out = m * in
+            void set_matrix(const float m[9])
+            {
+                std::memcpy(matrix_, m, sizeof(matrix_));
+            }
+
+            // 输出编码 out = in ^ (1 / gamma)，1 为不做 gamma
+            void set_gamma(float gamma)
+            {
+                gamma_ = gamma;
+            }
+
+            void reset()
+            {
+                gains_[0] = gains_[1] = gains_[2] = 1.0f;
+                const float identity[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+                set_matrix(identity);
+                gamma_ = 1.0f;
+            }
+
+            // 灰度世界假设：让三个通道的平均值相等（以 G 为基准）
+            template <size_t WIDTH, size_t HEIGHT, typename Derived>
+            bool gray_world(const ImageBase<PixelFormat::RGB565, WIDTH, HEIGHT, Derived> &src)
+            {
+                const uint16_t *in = static_cast<const uint16_t *>(static_cast<const Derived &>(src).get_data_ptr());
+                uint64_t sum[3] = {0, 0, 0};
+                for (size_t i = 0; i < WIDTH * HEIGHT; ++i)
+                {
+                    sum[0] += in[i] >> 11;
+                    sum[1] += (in[i] >> 5) & 0x3F;
+                    sum[2] += in[i] & 0x1F;
+                }
+                // 化到同一量纲（G 有 6 位）
+                float mean_r = sum[0] * (63.0f / 31.0f);
+                float mean_g = static_cast<float>(sum[1]);
+                float mean_b = sum[2] * (63.0f / 31.0f);
+                if (mean_r == 0 || mean_g == 0 || mean_b == 0)
+                    return false;
+                set_gains(mean_g / mean_r, 1.0f, mean_g / mean_b);
+                return true;
+            }
+
+            void update()
+            {
+                // 输入各级别乘上增益和矩阵后的贡献（Q12）
+                int32_t contrib[3][3][64];
+                const int levels[3] = {32, 64, 32};
+                for (int i = 0; i < 3; ++i)
+                {
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        float k = matrix_[i * 3 + j] * gains_[j] * ONE / (levels[j] - 1);
+                        for (int v = 0; v < levels[j]; ++v)
+                        {
+                            contrib[i][j][v] = static_cast<int32_t>(std::lround(k * v));
+                        }
+                    }
+                }
+
+                // 输出曲线：Q12 -> 对应通道的级别，已移到 RGB565 字中的位置
+                const int shift[3] = {11, 5, 0};
+                for (int i = 0; i < 3; ++i)
+                {
+                    for (int32_t v = 0; v <= ONE; ++v)
+                    {
+                        float x = static_cast<float>(v) / ONE;
+                        if (gamma_ != 1.0f)
+                            x = std::pow(x, 1.0f / gamma_);
+                        curve_[i][v] = static_cast<uint16_t>(std::lround(x * (levels[i] - 1)) << shift[i]);
+                    }
+                }
+
+                for (uint32_t r = 0; r < 32; ++r)
+                {
+                    for (uint32_t g = 0; g < 64; ++g)
+                    {
+                        int32_t rg[3];
+                        for (int i = 0; i < 3; ++i)
+                            rg[i] = contrib[i][0][r] + contrib[i][1][g];
+                        uint16_t *row = &table_[r << 11 | g << 5];
+                        for (uint32_t b = 0; b < 32; ++b)
+                        {
+                            row[b] = static_cast<uint16_t>(curve_[0][clamp_(rg[0] + contrib[0][2][b])] |
+                                                           curve_[1][clamp_(rg[1] + contrib[1][2][b])] |
+                                                           curve_[2][clamp_(rg[2] + contrib[2][2][b])]);
+                        }
+                    }
+                }
+            }
+
+            uint16_t map(uint16_t word) const
+            {
+                return table_[word];
+            }
+
+            RGB565Pixel map(RGB565Pixel pixel) const
+            {
+                uint16_t word;
+                std::memcpy(&word, &pixel, sizeof(word));
+                word = table_[word];
+                std::memcpy(&pixel, &word, sizeof(word));
+                return pixel;
+            }
+
+            const std::array<uint16_t, 65536> &table() const { return table_; }
+
+            // 原地校正，Image 和 ImageView 都可以
+            template <size_t WIDTH, size_t HEIGHT, typename Derived>
+            void apply(ImageBase<PixelFormat::RGB565, WIDTH, HEIGHT, Derived> &img) const
+            {
+                apply_row(static_cast<uint16_t *>(img.get_data_ptr()), WIDTH * HEIGHT);
+            }
+
+            void apply_row(uint16_t *row, size_t n) const
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    row[i] = table_[row[i]];
+                }
+            }
+
+        private:
+            static constexpr int32_t ONE = 4096;
+
+            static int32_t clamp_(int32_t v)
+            {
+                return v < 0 ? 0 : (v > ONE ? ONE : v);
+            }
+
+            float gains_[3] = {1.0f, 1.0f, 1.0f};
+            float matrix_[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+            float gamma_ = 1.0f;
+
+            uint16_t curve_[3][ONE + 1];
+            std::array<uint16_t, 65536> table_;
+        };
+
+        // 与 image::raw_to_rgb565 相同的读取（大端），读入时直接校正，不需要再遍历一遍
+        template <size_t WIDTH, size_t HEIGHT>
+        inline void raw_to_rgb565(const uint8_t *src, Image<PixelFormat::RGB565, WIDTH, HEIGHT> &dst,
+                                  const ColorCorrection &cc)
+        {
+            uint16_t *out = static_cast<uint16_t *>(dst.get_data_ptr());
+            for (size_t i = 0; i < WIDTH * HEIGHT; ++i)
+            {
+                out[i] = cc.map(static_cast<uint16_t>(src[2 * i] << 8 | src[2 * i + 1]));
+            }
+        }
+
+    }
+}
@@ -2,6 +2,8 @@
 
 #include <cstdint>
 #include <cmath>
+#include <array>
+#include <algorithm>
 #include "dv/image.hpp"
 
 namespace dv
@@ -20,6 +22,29 @@ namespace dv
             }
         }
 
+        // 水平 span [x0, x1)，先整体裁剪；行连续的图像直接按行指针填充，其余（二值、平面等）逐像素写入
+        template <PixelFormat PF, size_t W, size_t H, typename Derived>
+        inline void hline(ImageBase<PF, W, H, Derived>& img, int x0, int x1, int y,
+                          typename PixelFormatTrait<PF>::type color)
+        {
+            if (y < 0 || y >= static_cast<int>(H))
+                return;
+            if (x0 < 0)
+                x0 = 0;
+            if (x1 > static_cast<int>(W))
+                x1 = static_cast<int>(W);
+            if (x0 >= x1)
+                return;
+            if constexpr (is_row_addressable<Derived>::value) {
+                auto *row = static_cast<typename PixelFormatTrait<PF>::type *>(img.get_data_ptr()) + size_t(y) * W;
+                std::fill(row + x0, row + x1, color);
+            } else {
+                for (int x = x0; x < x1; ++x) {
+                    img(x, y) = color;
+                }
+            }
+        }
+
         template <PixelFormat PF, size_t W, size_t H, typename Derived>
         inline void line(ImageBase<PF, W, H, Derived>& img, int x0, int y0, int x1, int y1,
                         typename PixelFormatTrait<PF>::type color)
@@ -126,17 +151,19 @@ namespace dv
             int ymax = (y0 < y1) ? y1 : y0;
 
             for (int y = ymin; y <= ymax; y++) {
-                for (int x = xmin; x <= xmax; x++) {
-                    point(img, x, y, color);
-                }
+                hline(img, xmin, xmax + 1, y, color);
             }
         }
 
+
         struct SimpleBitmapFont {
             static constexpr uint8_t char_width = 5;
             static constexpr uint8_t char_height = 7;
+            // 字模只有 5 行数据，其余 2 行作为行间距
+            static constexpr uint8_t glyph_rows = 5;
+            static constexpr char first_char = ' ';
 
-            static inline constexpr uint8_t font_data[][5] = {
+            static inline constexpr uint8_t font_data[][glyph_rows] = {
                 // 空格
                 {0b00000, 0b00000, 0b00000, 0b00000, 0b00000},
                 // !
@@ -230,54 +257,402 @@ namespace dv
                 {0b10001, 0b01010, 0b00100, 0b01010, 0b10001}, // X
                 {0b10001, 0b01010, 0b00100, 0b00100, 0b00100}, // Y
                 {0b11111, 0b00010, 0b00100, 0b01000, 0b11111}, // Z
+                // [
+                {0b01110, 0b01000, 0b01000, 0b01000, 0b01110},
+                // 反斜杠
+                {0b10000, 0b01000, 0b00100, 0b00010, 0b00001},
+                // ]
+                {0b01110, 0b00010, 0b00010, 0b00010, 0b01110},
+                // ^
+                {0b00100, 0b01010, 0b10001, 0b00000, 0b00000},
+                // _
+                {0b00000, 0b00000, 0b00000, 0b00000, 0b11111},
+                // `
+                {0b01000, 0b00100, 0b00000, 0b00000, 0b00000},
+                // a-z
+                {0b00000, 0b01111, 0b10001, 0b10011, 0b01101}, // a
+                {0b10000, 0b10000, 0b11110, 0b10001, 0b11110}, // b
+                {0b00000, 0b01111, 0b10000, 0b10000, 0b01111}, // c
+                {0b00001, 0b00001, 0b01111, 0b10001, 0b01111}, // d
+                {0b01110, 0b10001, 0b11111, 0b10000, 0b01110}, // e
+                {0b00110, 0b01000, 0b11100, 0b01000, 0b01000}, // f
+                {0b01111, 0b10001, 0b01111, 0b00001, 0b01110}, // g
+                {0b10000, 0b10000, 0b11110, 0b10001, 0b10001}, // h
+                {0b00100, 0b00000, 0b01100, 0b00100, 0b01110}, // i
+                {0b00010, 0b00000, 0b00010, 0b10010, 0b01100}, // j
+                {0b10000, 0b10010, 0b11100, 0b10010, 0b10001}, // k
+                {0b01100, 0b00100, 0b00100, 0b00100, 0b01110}, // l
+                {0b00000, 0b11010, 0b10101, 0b10101, 0b10101}, // m
+                {0b00000, 0b11110, 0b10001, 0b10001, 0b10001}, // n
+                {0b00000, 0b01110, 0b10001, 0b10001, 0b01110}, // o
+                {0b11110, 0b10001, 0b11110, 0b10000, 0b10000}, // p
+                {0b01111, 0b10001, 0b01111, 0b00001, 0b00001}, // q
+                {0b00000, 0b10110, 0b11000, 0b10000, 0b10000}, // r
+                {0b01111, 0b10000, 0b01110, 0b00001, 0b11110}, // s
+                {0b01000, 0b11100, 0b01000, 0b01001, 0b00110}, // t
+                {0b00000, 0b10001, 0b10001, 0b10011, 0b01101}, // u
+                {0b00000, 0b10001, 0b10001, 0b01010, 0b00100}, // v
+                {0b00000, 0b10001, 0b10101, 0b10101, 0b01010}, // w
+                {0b00000, 0b10010, 0b01100, 0b01100, 0b10010}, // x
+                {0b10001, 0b10001, 0b01111, 0b00001, 0b01110}, // y
+                {0b00000, 0b11111, 0b00010, 0b01100, 0b11111}, // z
+                // {
+                {0b00110, 0b00100, 0b01000, 0b00100, 0b00110},
+                // |
+                {0b00100, 0b00100, 0b00100, 0b00100, 0b00100},
+                // }
+                {0b01100, 0b00100, 0b00010, 0b00100, 0b01100},
+                // ~
+                {0b00000, 0b01000, 0b10101, 0b00010, 0b00000},
             };
+
+            static constexpr size_t glyph_count = sizeof(font_data) / sizeof(font_data[0]);
         };
 
-        template <PixelFormat PF, size_t W, size_t H, typename Derived>
-        inline void char_draw(ImageBase<PF, W, H, Derived>& img, int x, int y, char ch,
-                             typename PixelFormatTrait<PF>::type color, int scale = 1)
+        // 预展开的字模缓存：每个 (Font, SCALE) 组合只在第一次使用时构建一次，
+        // 每行字模被展开成若干个已缩放的水平 span，绘制时按行整段填充
+        template <typename Font, int SCALE>
+        class GlyphCache
         {
-            // 支持的字符范围：空格(32)到'Z'(90)
-            int char_idx = static_cast<int>(ch) - 32;
-            if (char_idx < 0 || char_idx > 58) {
-                return; // 不支持的字符
+        public:
+            static_assert(SCALE > 0, "SCALE must be positive");
+
+            static constexpr int max_spans = (Font::char_width + 1) / 2;
+            static constexpr int glyph_width = Font::char_width * SCALE;
+            static constexpr int glyph_height = Font::glyph_rows * SCALE;
+
+            struct Span
+            {
+                int16_t x0; // [x0, x1)，相对字符左上角
+                int16_t x1;
+            };
+
+            struct Row
+            {
+                uint8_t count;
+                Span spans[max_spans];
+            };
+
+            struct Glyph
+            {
+                Row rows[Font::glyph_rows];
+                bool empty;
+            };
+
+            static const GlyphCache &instance()
+            {
+                const static GlyphCache cache;
+                return cache;
             }
 
-            const auto& font = SimpleBitmapFont::font_data[char_idx];
+            const Glyph *find(char ch) const
+            {
+                int idx = static_cast<int>(static_cast<unsigned char>(ch)) - static_cast<int>(Font::first_char);
+                if (idx < 0 || idx >= static_cast<int>(Font::glyph_count))
+                    return nullptr;
+                return &glyphs_[idx];
+            }
 
-            for (int row = 0; row < SimpleBitmapFont::char_height; row++) {
-                uint8_t row_data = font[row];
-                for (int col = 0; col < SimpleBitmapFont::char_width; col++) {
-                    if (row_data & (1 << (SimpleBitmapFont::char_width - 1 - col))) {
-                        for (int sy = 0; sy < scale; sy++) {
-                            for (int sx = 0; sx < scale; sx++) {
-                                point(img, x + col * scale + sx, y + row * scale + sy, color);
+        private:
+            GlyphCache()
+            {
+                for (size_t g = 0; g < Font::glyph_count; ++g)
+                {
+                    Glyph &glyph = glyphs_[g];
+                    glyph.empty = true;
+                    for (int row = 0; row < Font::glyph_rows; ++row)
+                    {
+                        uint8_t row_data = Font::font_data[g][row];
+                        Row &r = glyph.rows[row];
+                        r.count = 0;
+                        int col = 0;
+                        while (col < Font::char_width)
+                        {
+                            auto lit = [&](int c)
+                            { return (row_data >> (Font::char_width - 1 - c)) & 1; };
+                            if (!lit(col))
+                            {
+                                ++col;
+                                continue;
                             }
+                            int start = col;
+                            while (col < Font::char_width && lit(col))
+                                ++col;
+                            r.spans[r.count++] = Span{static_cast<int16_t>(start * SCALE),
+                                                      static_cast<int16_t>(col * SCALE)};
                         }
+                        if (r.count)
+                            glyph.empty = false;
                     }
                 }
             }
+
+            std::array<Glyph, Font::glyph_count> glyphs_;
+        };
+
+        template <int SCALE, typename Font, PixelFormat PF, size_t W, size_t H, typename Derived>
+        inline void glyph_blit(ImageBase<PF, W, H, Derived> &img, int x, int y,
+                               const typename GlyphCache<Font, SCALE>::Glyph &glyph,
+                               typename PixelFormatTrait<PF>::type color)
+        {
+            using Cache = GlyphCache<Font, SCALE>;
+            if (glyph.empty || x >= static_cast<int>(W) || x + Cache::glyph_width <= 0 ||
+                y >= static_cast<int>(H) || y + Cache::glyph_height <= 0)
+                return;
+
+            for (int row = 0; row < Font::glyph_rows; ++row)
+            {
+                const auto &r = glyph.rows[row];
+                if (r.count == 0)
+                    continue;
+                int y0 = std::max(y + row * SCALE, 0);
+                int y1 = std::min(y + (row + 1) * SCALE, static_cast<int>(H));
+                for (int yy = y0; yy < y1; ++yy)
+                {
+                    for (int s = 0; s < r.count; ++s)
+                    {
+                        hline(img, x + r.spans[s].x0, x + r.spans[s].x1, yy, color);
+                    }
+                }
+            }
+        }
+
+        template <int SCALE, typename Font = SimpleBitmapFont, PixelFormat PF, size_t W, size_t H, typename Derived>
+        inline void text_scaled(ImageBase<PF, W, H, Derived> &img, int x, int y, const char *text,
+                                typename PixelFormatTrait<PF>::type color)
+        {
+            const auto &cache = GlyphCache<Font, SCALE>::instance();
+            constexpr int advance = (Font::char_width + 1) * SCALE;
+            constexpr int line_height = (Font::char_height + 1) * SCALE;
+
+            int cur_x = x;
+            for (const char *p = text; *p != '\0'; p++)
+            {
+                if (*p == '\n')
+                {
+                    cur_x = x;
+                    y += line_height;
+                    continue;
+                }
+                // 整行都在图像外时跳过剩余字符
+                if (y >= static_cast<int>(H) || cur_x >= static_cast<int>(W))
+                {
+                    while (p[1] != '\0' && p[1] != '\n')
+                        p++;
+                    continue;
+                }
+                if (const auto *glyph = cache.find(*p))
+                    glyph_blit<SCALE, Font>(img, cur_x, y, *glyph, color);
+                cur_x += advance;
+            }
         }
 
         template <PixelFormat PF, size_t W, size_t H, typename Derived>
         inline void text(ImageBase<PF, W, H, Derived>& img, int x, int y, const char* text,
                         typename PixelFormatTrait<PF>::type color, int scale = 1)
         {
-            int cur_x = x;
-            const int char_width = SimpleBitmapFont::char_width * scale;
-            const int char_height = SimpleBitmapFont::char_height * scale;
+            switch (scale)
+            {
+            case 1: text_scaled<1>(img, x, y, text, color); return;
+            case 2: text_scaled<2>(img, x, y, text, color); return;
+            case 3: text_scaled<3>(img, x, y, text, color); return;
+            case 4: text_scaled<4>(img, x, y, text, color); return;
+            default: break;
+            }
+            if (scale <= 0)
+                return;
 
-            for (const char* p = text; *p != '\0'; p++) {
-                if (*p == '\n') {
+            // 不常用的缩放倍数：复用 1 倍字模，绘制时再放大
+            using Font = SimpleBitmapFont;
+            const auto &cache = GlyphCache<Font, 1>::instance();
+            int cur_x = x;
+            for (const char *p = text; *p != '\0'; p++)
+            {
+                if (*p == '\n')
+                {
                     cur_x = x;
-                    y += char_height + scale;
-                } else {
-                    char_draw(img, cur_x, y, *p, color, scale);
-                    cur_x += char_width + scale;
+                    y += (Font::char_height + 1) * scale;
+                    continue;
                 }
+                if (const auto *glyph = cache.find(*p))
+                {
+                    for (int row = 0; row < Font::glyph_rows; ++row)
+                    {
+                        const auto &r = glyph->rows[row];
+                        for (int s = 0; s < r.count; ++s)
+                        {
+                            for (int yy = y + row * scale; yy < y + (row + 1) * scale; ++yy)
+                                hline(img, cur_x + r.spans[s].x0 * scale, cur_x + r.spans[s].x1 * scale, yy, color);
+                        }
+                    }
+                }
+                cur_x += (Font::char_width + 1) * scale;
             }
         }
 
+        template <PixelFormat PF, size_t W, size_t H, typename Derived>
+        inline void char_draw(ImageBase<PF, W, H, Derived>& img, int x, int y, char ch,
+                             typename PixelFormatTrait<PF>::type color, int scale = 1)
+        {
+            const char str[2] = {ch, '\0'};
+            text(img, x, y, str, color, scale);
+        }
+
+        // 每帧都要刷新的 HUD 数字：字段位置和颜色只登记一次，
+        // 之后只更新内容，render() 一次性把所有字段画到图像上
+        template <PixelFormat PF, size_t MAX_FIELDS = 8, size_t MAX_CHARS = 24,
+                  int SCALE = 1, typename Font = SimpleBitmapFont>
+        class HudText
+        {
+        public:
+            using ColorT = typename PixelFormatTrait<PF>::type;
+
+            int add(int x, int y, ColorT color, const char *label = nullptr)
+            {
+                if (count_ >= MAX_FIELDS)
+                    return -1;
+                Field &f = fields_[count_];
+                f.x = x;
+                f.y = y;
+                f.color = color;
+                f.label_len = 0;
+                if (label)
+                {
+                    while (label[f.label_len] != '\0' && f.label_len < MAX_CHARS)
+                    {
+                        f.buf[f.label_len] = label[f.label_len];
+                        f.label_len++;
+                    }
+                }
+                f.len = f.label_len;
+                f.buf[f.len] = '\0';
+                return static_cast<int>(count_++);
+            }
+
+            void set_text(int id, const char *str)
+            {
+                Field *f = field(id);
+                if (!f)
+                    return;
+                size_t n = f->label_len;
+                while (*str != '\0' && n < MAX_CHARS)
+                    f->buf[n++] = *str++;
+                f->len = n;
+                f->buf[n] = '\0';
+            }
+
+            void set_int(int id, int32_t value)
+            {
+                set_fixed(id, value, 0);
+            }
+
+            // value / 10^decimals，例如 set_fixed(id, 1234, 2) 显示 "12.34"
+            void set_fixed(int id, int32_t value, int decimals)
+            {
+                Field *f = field(id);
+                if (!f)
+                    return;
+                char digits[16];
+                int n = 0;
+                bool negative = value < 0;
+                uint32_t v = negative ? 0u - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+                do
+                {
+                    if (decimals > 0 && n == decimals)
+                        digits[n++] = '.';
+                    digits[n++] = static_cast<char>('0' + v % 10);
+                    v /= 10;
+                } while ((v != 0 || n <= decimals) && n < static_cast<int>(sizeof(digits)) - 1);
+                if (negative)
+                    digits[n++] = '-';
+
+                size_t len = f->label_len;
+                while (n > 0 && len < MAX_CHARS)
+                    f->buf[len++] = digits[--n];
+                f->len = len;
+                f->buf[len] = '\0';
+            }
+
+            void clear(int id)
+            {
+                if (Field *f = field(id))
+                {
+                    f->len = f->label_len;
+                    f->buf[f->len] = '\0';
+                }
+            }
+
+            size_t size() const { return count_; }
+
+            template <size_t W, size_t H, typename Derived>
+            void render(ImageBase<PF, W, H, Derived> &img) const
+            {
+                const auto &cache = GlyphCache<Font, SCALE>::instance();
+                constexpr int advance = (Font::char_width + 1) * SCALE;
+                for (size_t i = 0; i < count_; ++i)
+                {
+                    const Field &f = fields_[i];
+                    int cur_x = f.x;
+                    for (size_t c = 0; c < f.len && cur_x < static_cast<int>(W); ++c, cur_x += advance)
+                    {
+                        if (const auto *glyph = cache.find(f.buf[c]))
+                            glyph_blit<SCALE, Font>(img, cur_x, f.y, *glyph, f.color);
+                    }
+                }
+            }
+
+            // 字段当前的完整内容（标签 + 数值），id 无效时返回 nullptr
+            const char *str(int id) const
+            {
+                const Field *f = field(id);
+                return f ? f->buf : nullptr;
+            }
+
+            // 字段在图像上占用的包围盒，便于只清除/重绘这一块；id 无效时返回 false 且全部置 0
+            bool bounds(int id, int &x0, int &y0, int &x1, int &y1) const
+            {
+                const Field *ptr = field(id);
+                if (!ptr)
+                {
+                    x0 = y0 = x1 = y1 = 0;
+                    return false;
+                }
+                const Field &f = *ptr;
+                x0 = f.x;
+                y0 = f.y;
+                x1 = f.x + static_cast<int>(f.len) * (Font::char_width + 1) * SCALE;
+                y1 = f.y + Font::glyph_rows * SCALE;
+                return true;
+            }
+
+        private:
+            struct Field
+            {
+                int x;
+                int y;
+                ColorT color;
+                size_t label_len;
+                size_t len;
+                char buf[MAX_CHARS + 1];
+            };
+
+            Field *field(int id)
+            {
+                if (id < 0 || static_cast<size_t>(id) >= count_)
+                    return nullptr;
+                return &fields_[id];
+            }
+
+            const Field *field(int id) const
+            {
+                if (id < 0 || static_cast<size_t>(id) >= count_)
+                    return nullptr;
+                return &fields_[id];
+            }
+
+            Field fields_[MAX_FIELDS];
+            size_t count_ = 0;
+        };
+
     }
 }
-
@@ -0,0 +1,362 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "dv/image.hpp"
+#include "dv/stream.hpp"
+
+namespace dv
+{
+    namespace gradient
+    {
+        using namespace image;
+        using namespace pixel_format;
+
+        // 3x3 梯度算子：外侧权重 A、中间权重 B
+        // Sobel: [1 2 1]，|dx|、|dy| <= 1020；Scharr: [3 10 3]，|dx|、|dy| <= 4080，都放得进 int16_t
+        enum class Kernel
+        {
+            Sobel,
+            Scharr,
+        };
+
+        template <Kernel K>
+        struct KernelWeights;
+
+        template <>
+        struct KernelWeights<Kernel::Sobel>
+        {
+            static constexpr int16_t outer = 1;
+            static constexpr int16_t center = 2;
+        };
+
+        template <>
+        struct KernelWeights<Kernel::Scharr>
+        {
+            static constexpr int16_t outer = 3;
+            static constexpr int16_t center = 10;
+        };
+
+        // 量化方向（图像坐标，y 向下）：0 水平梯度，1 沿 (1, 1)，2 竖直梯度，3 沿 (1, -1)
+        inline uint8_t quantize_direction(int16_t dx, int16_t dy)
+        {
+            int32_t ax = dx < 0 ? -dx : dx;
+            int32_t ay = dy < 0 ? -dy : dy;
+            // tan(22.5°) ≈ 106 / 256，tan(67.5°) ≈ 618 / 256
+            if (ay * 256 <= ax * 106)
+                return 0;
+            if (ay * 256 >= ax * 618)
+                return 2;
+            return ((dx ^ dy) >= 0) ? 1 : 3;
+        }
+
+        // 由上中下三行求中间一行的 dx/dy，首尾两列为 0
+        template <Kernel K, size_t WIDTH>
+        inline void gradient_row(const uint8_t *up, const uint8_t *mid, const uint8_t *down, int16_t *dx, int16_t *dy)
+        {
+            constexpr int16_t A = KernelWeights<K>::outer;
+            constexpr int16_t B = KernelWeights<K>::center;
+            dx[0] = dy[0] = 0;
+            size_t x = 1;
+#if defined(__AVX2__)
+            const __m256i va = _mm256_set1_epi16(A);
+            const __m256i vb = _mm256_set1_epi16(B);
+            auto load16 = [](const uint8_t *p)
+            { return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))); };
+            for (; x + 16 + 1 <= WIDTH; x += 16)
+            {
+                __m256i ul = load16(up + x - 1), uc = load16(up + x), ur = load16(up + x + 1);
+                __m256i ml = load16(mid + x - 1), mr = load16(mid + x + 1);
+                __m256i dl = load16(down + x - 1), dc = load16(down + x), dr = load16(down + x + 1);
+                __m256i gx = _mm256_add_epi16(_mm256_mullo_epi16(va, _mm256_add_epi16(_mm256_sub_epi16(ur, ul), _mm256_sub_epi16(dr, dl))),
+                                              _mm256_mullo_epi16(vb, _mm256_sub_epi16(mr, ml)));
+                __m256i gy = _mm256_add_epi16(_mm256_mullo_epi16(va, _mm256_add_epi16(_mm256_sub_epi16(dl, ul), _mm256_sub_epi16(dr, ur))),
+                                              _mm256_mullo_epi16(vb, _mm256_sub_epi16(dc, uc)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dx + x), gx);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dy + x), gy);
+            }
+#elif defined(__SSE2__)
+            const __m128i va = _mm_set1_epi16(A);
+            const __m128i vb = _mm_set1_epi16(B);
+            const __m128i zero = _mm_setzero_si128();
+            auto load8 = [&](const uint8_t *p)
+            { return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)), zero); };
+            for (; x + 8 + 1 <= WIDTH; x += 8)
+            {
+                __m128i ul = load8(up + x - 1), uc = load8(up + x), ur = load8(up + x + 1);
+                __m128i ml = load8(mid + x - 1), mr = load8(mid + x + 1);
+                __m128i dl = load8(down + x - 1), dc = load8(down + x), dr = load8(down + x + 1);
+                __m128i gx = _mm_add_epi16(_mm_mullo_epi16(va, _mm_add_epi16(_mm_sub_epi16(ur, ul), _mm_sub_epi16(dr, dl))),
+                                           _mm_mullo_epi16(vb, _mm_sub_epi16(mr, ml)));
+                __m128i gy = _mm_add_epi16(_mm_mullo_epi16(va, _mm_add_epi16(_mm_sub_epi16(dl, ul), _mm_sub_epi16(dr, ur))),
+                                           _mm_mullo_epi16(vb, _mm_sub_epi16(dc, uc)));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dx + x), gx);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dy + x), gy);
+            }
+#elif defined(__ARM_NEON)
+            auto load8 = [](const uint8_t *p)
+            { return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(p))); };
+            for (; x + 8 + 1 <= WIDTH; x += 8)
+            {
+                int16x8_t ul = load8(up + x - 1), uc = load8(up + x), ur = load8(up + x + 1);
+                int16x8_t ml = load8(mid + x - 1), mr = load8(mid + x + 1);
+                int16x8_t dl = load8(down + x - 1), dc = load8(down + x), dr = load8(down + x + 1);
+                int16x8_t gx = vmlaq_n_s16(vmulq_n_s16(vaddq_s16(vsubq_s16(ur, ul), vsubq_s16(dr, dl)), A), vsubq_s16(mr, ml), B);
+                int16x8_t gy = vmlaq_n_s16(vmulq_n_s16(vaddq_s16(vsubq_s16(dl, ul), vsubq_s16(dr, ur)), A), vsubq_s16(dc, uc), B);
+                vst1q_s16(dx + x, gx);
+                vst1q_s16(dy + x, gy);
+            }
+#endif
+            for (; x + 1 < WIDTH; ++x)
+            {
+                dx[x] = static_cast<int16_t>(A * ((up[x + 1] - up[x - 1]) + (down[x + 1] - down[x - 1])) + B * (mid[x + 1] - mid[x - 1]));
+                dy[x] = static_cast<int16_t>(A * ((down[x - 1] - up[x - 1]) + (down[x + 1] - up[x + 1])) + B * (down[x] - up[x]));
+            }
+            if (WIDTH > 1)
+                dx[WIDTH - 1] = dy[WIDTH - 1] = 0;
+        }
+
+        // L1 幅值 |dx| + |dy|
+        template <size_t WIDTH>
+        inline void magnitude_row(const int16_t *dx, const int16_t *dy, uint16_t *mag)
+        {
+            size_t x = 0;
+#if defined(__AVX2__)
+            for (; x < WIDTH / 16 * 16; x += 16)
+            {
+                __m256i gx = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dx + x));
+                __m256i gy = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dy + x));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(mag + x), _mm256_add_epi16(_mm256_abs_epi16(gx), _mm256_abs_epi16(gy)));
+            }
+#elif defined(__SSE2__)
+            const __m128i zero = _mm_setzero_si128();
+            for (; x < WIDTH / 8 * 8; x += 8)
+            {
+                __m128i gx = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dx + x));
+                __m128i gy = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dy + x));
+                __m128i ax = _mm_max_epi16(gx, _mm_sub_epi16(zero, gx));
+                __m128i ay = _mm_max_epi16(gy, _mm_sub_epi16(zero, gy));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(mag + x), _mm_add_epi16(ax, ay));
+            }
+#elif defined(__ARM_NEON)
+            for (; x < WIDTH / 8 * 8; x += 8)
+            {
+                int16x8_t s = vaddq_s16(vabsq_s16(vld1q_s16(dx + x)), vabsq_s16(vld1q_s16(dy + x)));
+                vst1q_u16(mag + x, vreinterpretq_u16_s16(s));
+            }
+#endif
+            for (; x < WIDTH; ++x)
+            {
+                mag[x] = static_cast<uint16_t>((dx[x] < 0 ? -dx[x] : dx[x]) + (dy[x] < 0 ? -dy[x] : dy[x]));
+            }
+        }
+
+        template <size_t WIDTH>
+        inline void direction_row(const int16_t *dx, const int16_t *dy, uint8_t *dir)
+        {
+            for (size_t x = 0; x < WIDTH; ++x)
+            {
+                dir[x] = quantize_direction(dx[x], dy[x]);
+            }
+        }
+
+        // 整帧梯度，边框一圈为 0
+        template <size_t WIDTH, size_t HEIGHT>
+        class Gradient
+        {
+        public:
+            template <Kernel K = Kernel::Sobel>
+            void compute(const Image<PixelFormat::Grayscale, WIDTH, HEIGHT> &src)
+            {
+                const uint8_t *img = static_cast<const uint8_t *>(src.get_data_ptr());
+                std::memset(dx_, 0, sizeof(int16_t) * WIDTH);
+                std::memset(dy_, 0, sizeof(int16_t) * WIDTH);
+                std::memset(mag_, 0, sizeof(uint16_t) * WIDTH);
+                for (size_t y = 1; y + 1 < HEIGHT; ++y)
+                {
+                    gradient_row<K, WIDTH>(img + (y - 1) * WIDTH, img + y * WIDTH, img + (y + 1) * WIDTH,
+                                           dx_ + y * WIDTH, dy_ + y * WIDTH);
+                    gradient::magnitude_row<WIDTH>(dx_ + y * WIDTH, dy_ + y * WIDTH, mag_ + y * WIDTH);
+                }
+                std::memset(dx_ + (HEIGHT - 1) * WIDTH, 0, sizeof(int16_t) * WIDTH);
+                std::memset(dy_ + (HEIGHT - 1) * WIDTH, 0, sizeof(int16_t) * WIDTH);
+                std::memset(mag_ + (HEIGHT - 1) * WIDTH, 0, sizeof(uint16_t) * WIDTH);
+            }
+
+            int16_t dx(size_t x, size_t y) const { return dx_[y * WIDTH + x]; }
+            int16_t dy(size_t x, size_t y) const { return dy_[y * WIDTH + x]; }
+            uint16_t magnitude(size_t x, size_t y) const { return mag_[y * WIDTH + x]; }
+            uint8_t direction(size_t x, size_t y) const { return quantize_direction(dx(x, y), dy(x, y)); }
+
+            const int16_t *dx_row(size_t y) const { return dx_ + y * WIDTH; }
+            const int16_t *dy_row(size_t y) const { return dy_ + y * WIDTH; }
+            const uint16_t *magnitude_row(size_t y) const { return mag_ + y * WIDTH; }
+
+        private:
+            int16_t dx_[WIDTH * HEIGHT];
+            int16_t dy_[WIDTH * HEIGHT];
+            uint16_t mag_[WIDTH * HEIGHT];
+        };
+
+        // 逐行的非极大值抑制边缘检测：灰度行进 3 行滚动缓冲，幅值和方向也只保留 3/2 行。
+        // 每个输入行之后按顺序输出已经确定的边缘行（打包位，格式同 stream::threshold_row），
+        // 边框一圈没有边缘。最后一行送入后调用 finish() 输出剩下的行。
+        template <size_t WIDTH, Kernel K = Kernel::Sobel>
+        class EdgeDetector
+        {
+        public:
+            explicit EdgeDetector(uint16_t threshold = 100) : threshold_(threshold) {}
+
+            void set_threshold(uint16_t threshold) { threshold_ = threshold; }
+
+            void reset()
+            {
+                rows_ = 0;
+                gray_.reset();
+                mag_.reset();
+                dir_.reset();
+            }
+
+            // emit(y, const uint8_t *bits)
+            template <typename Fn>
+            void push_row(const uint8_t *row, Fn &&emit)
+            {
+                gray_.push_row(row);
+                rows_++;
+                if (rows_ == 1)
+                {
+                    push_zero_row();
+                    std::memset(bits_, 0, sizeof(bits_));
+                    emit(size_t(0), static_cast<const uint8_t *>(bits_));
+                }
+                if (rows_ >= 3)
+                {
+                    gradient_row<K, WIDTH>(gray_.row(2), gray_.row(1), gray_.row(0), dx_, dy_);
+                    magnitude_row<WIDTH>(dx_, dy_, mag_.next());
+                    mag_.commit();
+                    direction_row<WIDTH>(dx_, dy_, dir_.next());
+                    dir_.commit();
+                }
+                if (rows_ >= 4)
+                    suppress(rows_ - 3, emit);
+            }
+
+            template <typename Fn>
+            void finish(Fn &&emit)
+            {
+                if (rows_ < 2)
+                    return;
+                push_zero_row();
+                if (rows_ >= 3)
+                    suppress(rows_ - 2, emit);
+                std::memset(bits_, 0, sizeof(bits_));
+                emit(rows_ - 1, static_cast<const uint8_t *>(bits_));
+            }
+
+        private:
+            void push_zero_row()
+            {
+                std::memset(mag_.next(), 0, sizeof(uint16_t) * WIDTH);
+                mag_.commit();
+                std::memset(dir_.next(), 0, WIDTH);
+                dir_.commit();
+            }
+
+            // 对幅值缓冲中间一行做非极大值抑制：沿梯度方向一侧严格大于、另一侧不小于
+            template <typename Fn>
+            void suppress(size_t y, Fn &&emit)
+            {
+                const uint16_t *up = mag_.row(2);
+                const uint16_t *mid = mag_.row(1);
+                const uint16_t *down = mag_.row(0);
+                const uint8_t *dir = dir_.row(1);
+                std::memset(bits_, 0, sizeof(bits_));
+                for (size_t x = 1; x + 1 < WIDTH; ++x)
+                {
+                    uint16_t m = mid[x];
+                    if (m <= threshold_)
+                        continue;
+                    uint16_t a, b;
+                    switch (dir[x])
+                    {
+                    case 0:
+                        a = mid[x - 1];
+                        b = mid[x + 1];
+                        break;
+                    case 1:
+                        a = up[x - 1];
+                        b = down[x + 1];
+                        break;
+                    case 2:
+                        a = up[x];
+                        b = down[x];
+                        break;
+                    default:
+                        a = up[x + 1];
+                        b = down[x - 1];
+                        break;
+                    }
+                    if (m > a && m >= b)
+                        bits_[x / 8] |= static_cast<uint8_t>(1u << (x % 8));
+                }
+                emit(y, static_cast<const uint8_t *>(bits_));
+            }
+
+            uint16_t threshold_;
+            size_t rows_ = 0;
+            stream::LineBuffer<uint8_t, WIDTH, 3> gray_;
+            stream::LineBuffer<uint16_t, WIDTH, 3> mag_;
+            stream::LineBuffer<uint8_t, WIDTH, 2> dir_;
+            int16_t dx_[WIDTH];
+            int16_t dy_[WIDTH];
+            uint8_t bits_[stream::row_bytes<WIDTH>()];
+        };
+
+        // 把一行打包位写到 Image<Binary> 的第 y 行（整帧连续打包，行不一定从字节边界开始）
+        template <size_t WIDTH, size_t HEIGHT>
+        inline void store_bits_(Image<PixelFormat::Binary, WIDTH, HEIGHT> &dst, size_t y, const uint8_t *bits)
+        {
+            uint8_t *out = static_cast<uint8_t *>(dst.get_data_ptr());
+            if (WIDTH % 8 == 0)
+            {
+                std::memcpy(out + y * WIDTH / 8, bits, WIDTH / 8);
+                return;
+            }
+            size_t base = y * WIDTH;
+            for (size_t x = 0; x < WIDTH; ++x)
+            {
+                size_t idx = base + x;
+                uint8_t mask = static_cast<uint8_t>(1u << (idx % 8));
+                if ((bits[x / 8] >> (x % 8)) & 1)
+                    out[idx / 8] |= mask;
+                else
+                    out[idx / 8] &= static_cast<uint8_t>(~mask);
+            }
+        }
+
+        // 整帧边缘图：幅值（L1）大于 threshold 且为沿梯度方向的局部极大值
+        template <Kernel K = Kernel::Sobel, size_t WIDTH, size_t HEIGHT>
+        inline void edges(const Image<PixelFormat::Grayscale, WIDTH, HEIGHT> &src,
+                          Image<PixelFormat::Binary, WIDTH, HEIGHT> &dst, uint16_t threshold)
+        {
+            EdgeDetector<WIDTH, K> detector(threshold);
+            const uint8_t *img = static_cast<const uint8_t *>(src.get_data_ptr());
+            auto emit = [&](size_t y, const uint8_t *bits)
+            { store_bits_(dst, y, bits); };
+            for (size_t y = 0; y < HEIGHT; ++y)
+            {
+                detector.push_row(img + y * WIDTH, emit);
+            }
+            detector.finish(emit);
+        }
+
+    }
+}
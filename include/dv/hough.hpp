@@ -0,0 +1,344 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include "dv/image.hpp"
+#include "dv/gradient.hpp"
+
+namespace dv
+{
+    namespace hough
+    {
+        using namespace image;
+        using namespace pixel_format;
+
+        struct EdgePoint
+        {
+            uint16_t x;
+            uint16_t y;
+            int16_t dx;
+            int16_t dy;
+        };
+
+        struct Circle
+        {
+            int x; // 圆心
+            int y;
+            int r;
+            uint32_t votes;   // 圆心 3x3 邻域内的票数
+            uint32_t support; // 落在半径 r 上的边缘点数
+        };
+
+        inline uint32_t isqrt_(uint32_t v)
+        {
+            uint32_t r = 0;
+            for (uint32_t bit = 1u << 30; bit; bit >>= 2)
+            {
+                if (v >= r + bit)
+                {
+                    v -= r + bit;
+                    r = (r >> 1) + bit;
+                }
+                else
+                {
+                    r >>= 1;
+                }
+            }
+            return r;
+        }
+
+        // 梯度方向的圆 Hough 变换：
+        // 1. 在 roi 内用 gradient 模块的整数 Sobel 求梯度，幅值（L1）超过阈值的像素放进稀疏边缘表；
+        // 2. 每个边缘点沿梯度正反两个方向，在 [min_radius, max_radius] 上给圆心投票；
+        // 3. 累加器做 3x3 平滑后取局部极大值作为圆心，再统计边缘点到圆心的距离直方图确定半径。
+        // 累加器大小固定为整帧，每次只清零 roi 部分。
+        template <size_t WIDTH, size_t HEIGHT, size_t MAX_EDGES = 4096, size_t MAX_CIRCLES = 8>
+        class CircleHough
+        {
+        public:
+            static_assert(MAX_EDGES * 2 <= UINT16_MAX, "accumulator cells may overflow");
+            static constexpr size_t MAX_CANDIDATES = 64;
+            static constexpr size_t MAX_RADIUS = 255;
+
+            void set_radius_range(int min_radius, int max_radius)
+            {
+                min_radius_ = std::max(min_radius, 1);
+                max_radius_ = std::min(std::max(max_radius, min_radius_), static_cast<int>(MAX_RADIUS));
+            }
+
+            // |dx| + |dy| 的阈值
+            void set_edge_threshold(int threshold) { edge_threshold_ = threshold; }
+            void set_min_votes(uint32_t votes) { min_votes_ = votes; }
+            // 两个圆心之间的最小距离
+            void set_min_distance(int distance) { min_distance_ = distance; }
+
+            size_t detect(const Image<PixelFormat::Grayscale, WIDTH, HEIGHT> &img, Rect roi)
+            {
+                roi = roi.clipped(WIDTH, HEIGHT);
+                circle_count_ = 0;
+                edge_count_ = 0;
+                dropped_edges_ = 0;
+                if (roi.x1 - roi.x0 < 3 || roi.y1 - roi.y0 < 3)
+                    return 0;
+
+                collect_edges(static_cast<const uint8_t *>(img.get_data_ptr()), roi);
+                vote(roi);
+                smooth(roi);
+                find_peaks(roi);
+                return circle_count_;
+            }
+
+            size_t circle_count() const { return circle_count_; }
+            const Circle &circle(size_t i) const { return circles_[i]; }
+
+            size_t edge_count() const { return edge_count_; }
+            const EdgePoint &edge(size_t i) const { return edges_[i]; }
+            // 边缘表已满而被丢弃的边缘点数
+            size_t dropped_edges() const { return dropped_edges_; }
+
+            // 平滑后的累加器
+            uint16_t votes(int x, int y) const { return acc_[y * WIDTH + x]; }
+
+        private:
+            void collect_edges(const uint8_t *img, const Rect &roi)
+            {
+                for (int y = roi.y0 + 1; y < roi.y1 - 1; ++y)
+                {
+                    const uint8_t *mid = img + y * WIDTH;
+                    gradient::gradient_row<gradient::Kernel::Sobel, WIDTH>(mid - WIDTH, mid, mid + WIDTH, dx_row_, dy_row_);
+                    for (int x = roi.x0 + 1; x < roi.x1 - 1; ++x)
+                    {
+                        int dx = dx_row_[x], dy = dy_row_[x];
+                        if (std::abs(dx) + std::abs(dy) <= edge_threshold_)
+                            continue;
+                        add_edge(x, y, dx, dy);
+                    }
+                }
+            }
+
+            void add_edge(int x, int y, int dx, int dy)
+            {
+                if (edge_count_ >= MAX_EDGES)
+                {
+                    dropped_edges_++;
+                    return;
+                }
+                edges_[edge_count_++] = EdgePoint{static_cast<uint16_t>(x), static_cast<uint16_t>(y),
+                                                  static_cast<int16_t>(dx), static_cast<int16_t>(dy)};
+            }
+
+            void vote(const Rect &roi)
+            {
+                for (int y = roi.y0; y < roi.y1; ++y)
+                {
+                    std::memset(&acc_[y * WIDTH + roi.x0], 0, sizeof(uint16_t) * (roi.x1 - roi.x0));
+                }
+
+                for (size_t i = 0; i < edge_count_; ++i)
+                {
+                    const EdgePoint &e = edges_[i];
+                    int32_t mag = static_cast<int32_t>(isqrt_(static_cast<uint32_t>(e.dx * e.dx + e.dy * e.dy)));
+                    if (mag == 0)
+                        continue;
+                    // Q14 单位方向
+                    int32_t ux = (e.dx * (1 << 14)) / mag;
+                    int32_t uy = (e.dy * (1 << 14)) / mag;
+                    for (int sign = -1; sign <= 1; sign += 2)
+                    {
+                        int32_t sx = sign * ux, sy = sign * uy;
+                        int32_t fx = (e.x << 14) + (1 << 13) + sx * min_radius_;
+                        int32_t fy = (e.y << 14) + (1 << 13) + sy * min_radius_;
+                        for (int r = min_radius_; r <= max_radius_; ++r, fx += sx, fy += sy)
+                        {
+                            int cx = fx >> 14, cy = fy >> 14;
+                            if (cx < roi.x0 || cx >= roi.x1 || cy < roi.y0 || cy >= roi.y1)
+                                break;
+                            acc_[cy * WIDTH + cx]++;
+                        }
+                    }
+                }
+            }
+
+            // 3x3 盒式滤波（饱和到 uint16_t）。离散梯度方向有几度的误差，
+            // 票会散到圆心周围几个像素，平滑后峰值更稳定
+            void smooth(const Rect &roi)
+            {
+                const int w = roi.x1 - roi.x0;
+                for (int y = roi.y0; y < roi.y1; ++y)
+                {
+                    uint16_t *row = &acc_[y * WIDTH + roi.x0];
+                    std::memcpy(row_a_, row, sizeof(uint16_t) * w);
+                    for (int x = 0; x < w; ++x)
+                    {
+                        uint32_t v = row_a_[x] + (x > 0 ? row_a_[x - 1] : 0) + (x + 1 < w ? row_a_[x + 1] : 0);
+                        row[x] = static_cast<uint16_t>(std::min<uint32_t>(v, UINT16_MAX));
+                    }
+                }
+                std::memset(row_a_, 0, sizeof(uint16_t) * w); // 上一行（滤波前）
+                for (int y = roi.y0; y < roi.y1; ++y)
+                {
+                    uint16_t *row = &acc_[y * WIDTH + roi.x0];
+                    const uint16_t *below = y + 1 < roi.y1 ? row + WIDTH : nullptr;
+                    std::memcpy(row_b_, row, sizeof(uint16_t) * w);
+                    for (int x = 0; x < w; ++x)
+                    {
+                        uint32_t v = row_a_[x] + row_b_[x] + (below ? below[x] : 0);
+                        row[x] = static_cast<uint16_t>(std::min<uint32_t>(v, UINT16_MAX));
+                    }
+                    std::memcpy(row_a_, row_b_, sizeof(uint16_t) * w);
+                }
+            }
+
+            void find_peaks(const Rect &roi)
+            {
+                // 3x3 局部极大值；平台上只保留光栅顺序的第一个
+                size_t candidate_count = 0;
+                for (int y = roi.y0; y < roi.y1; ++y)
+                {
+                    for (int x = roi.x0; x < roi.x1; ++x)
+                    {
+                        uint16_t v = acc_[y * WIDTH + x];
+                        if (v < min_votes_ || v == 0)
+                            continue;
+                        bool peak = true;
+                        for (int j = -1; j <= 1 && peak; ++j)
+                        {
+                            for (int i = -1; i <= 1; ++i)
+                            {
+                                int nx = x + i, ny = y + j;
+                                if ((i == 0 && j == 0) || nx < roi.x0 || nx >= roi.x1 || ny < roi.y0 || ny >= roi.y1)
+                                    continue;
+                                uint16_t n = acc_[ny * WIDTH + nx];
+                                bool before = j < 0 || (j == 0 && i < 0);
+                                if (n > v || (before && n == v))
+                                {
+                                    peak = false;
+                                    break;
+                                }
+                            }
+                        }
+                        if (peak)
+                            insert_candidate(candidate_count, x, y, v);
+                    }
+                }
+
+                // 按票数从高到低，去掉离已选圆心太近的
+                const int min_dist2 = min_distance_ * min_distance_;
+                for (size_t c = 0; c < candidate_count && circle_count_ < MAX_CIRCLES; ++c)
+                {
+                    const Circle &cand = candidates_[c];
+                    bool close = false;
+                    for (size_t k = 0; k < circle_count_ && !close; ++k)
+                    {
+                        int ddx = circles_[k].x - cand.x, ddy = circles_[k].y - cand.y;
+                        close = ddx * ddx + ddy * ddy < min_dist2;
+                    }
+                    if (close)
+                        continue;
+                    Circle circle = cand;
+                    refine_center(circle, roi);
+                    if (estimate_radius(circle))
+                        circles_[circle_count_++] = circle;
+                }
+            }
+
+            // 圆心附近的票数是一个平台，极大值可能落在平台边上：
+            // 在 7x7 窗口内对高于峰值 3/4 的部分求加权质心，迭代几次
+            void refine_center(Circle &circle, const Rect &roi) const
+            {
+                const int32_t floor_votes = static_cast<int32_t>(circle.votes * 3 / 4);
+                for (int iter = 0; iter < 3; ++iter)
+                {
+                    int64_t sw = 0, sx = 0, sy = 0;
+                    for (int y = std::max(circle.y - 3, roi.y0); y <= std::min(circle.y + 3, roi.y1 - 1); ++y)
+                    {
+                        for (int x = std::max(circle.x - 3, roi.x0); x <= std::min(circle.x + 3, roi.x1 - 1); ++x)
+                        {
+                            int32_t w = acc_[y * WIDTH + x] - floor_votes;
+                            if (w <= 0)
+                                continue;
+                            sw += w;
+                            sx += static_cast<int64_t>(w) * x;
+                            sy += static_cast<int64_t>(w) * y;
+                        }
+                    }
+                    if (sw == 0)
+                        return;
+                    int nx = static_cast<int>((2 * sx + sw) / (2 * sw));
+                    int ny = static_cast<int>((2 * sy + sw) / (2 * sw));
+                    if (nx == circle.x && ny == circle.y)
+                        return;
+                    circle.x = nx;
+                    circle.y = ny;
+                }
+            }
+
+            void insert_candidate(size_t &count, int x, int y, uint32_t v)
+            {
+                size_t pos = count < MAX_CANDIDATES ? count : MAX_CANDIDATES;
+                while (pos > 0 && candidates_[pos - 1].votes < v)
+                    pos--;
+                if (pos >= MAX_CANDIDATES)
+                    return;
+                size_t last = count < MAX_CANDIDATES ? count : MAX_CANDIDATES - 1;
+                for (size_t k = last; k > pos; --k)
+                    candidates_[k] = candidates_[k - 1];
+                candidates_[pos] = Circle{x, y, 0, v, 0};
+                if (count < MAX_CANDIDATES)
+                    count++;
+            }
+
+            // 边缘点到圆心距离（四舍五入）的直方图，相邻三格平滑后取最大
+            bool estimate_radius(Circle &circle) const
+            {
+                uint32_t hist[MAX_RADIUS + 2] = {0};
+                for (size_t i = 0; i < edge_count_; ++i)
+                {
+                    int ddx = edges_[i].x - circle.x, ddy = edges_[i].y - circle.y;
+                    uint32_t d2 = static_cast<uint32_t>(ddx * ddx + ddy * ddy);
+                    // round(sqrt(d2)) = (floor(sqrt(4 * d2)) + 1) / 2
+                    uint32_t d = (isqrt_(4 * d2) + 1) / 2;
+                    if (d >= static_cast<uint32_t>(min_radius_) && d <= static_cast<uint32_t>(max_radius_))
+                        hist[d]++;
+                }
+                uint32_t best = 0;
+                for (int r = min_radius_; r <= max_radius_; ++r)
+                {
+                    uint32_t s = hist[r - 1] + 2 * hist[r] + hist[r + 1];
+                    if (s > best)
+                    {
+                        best = s;
+                        circle.r = r;
+                        circle.support = hist[r - 1] + hist[r] + hist[r + 1];
+                    }
+                }
+                return best > 0;
+            }
+
+            int min_radius_ = 4;
+            int max_radius_ = 64;
+            int edge_threshold_ = 200;
+            uint32_t min_votes_ = 64;
+            int min_distance_ = 8;
+
+            EdgePoint edges_[MAX_EDGES];
+            size_t edge_count_ = 0;
+            size_t dropped_edges_ = 0;
+
+            uint16_t acc_[WIDTH * HEIGHT];
+            int16_t dx_row_[WIDTH];
+            int16_t dy_row_[WIDTH];
+            uint16_t row_a_[WIDTH];
+            uint16_t row_b_[WIDTH];
+
+            Circle candidates_[MAX_CANDIDATES];
+            Circle circles_[MAX_CIRCLES];
+            size_t circle_count_ = 0;
+        };
+
+    }
+}
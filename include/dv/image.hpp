@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
+#include <algorithm>
+#include <type_traits>
 
 #include "dv/pixel_format.hpp"
 
@@ -12,6 +14,48 @@ namespace dv
     {
         using namespace pixel_format;
 
+        // 图像中的矩形区域，半开区间 [x0, x1) x [y0, y1)
+        struct Rect
+        {
+            int x0;
+            int y0;
+            int x1;
+            int y1;
+
+            bool empty() const
+            {
+                return x0 >= x1 || y0 >= y1;
+            }
+
+            bool intersects(const Rect &other) const
+            {
+                return !empty() && !other.empty() &&
+                       x0 < other.x1 && other.x0 < x1 &&
+                       y0 < other.y1 && other.y0 < y1;
+            }
+
+            bool contains(const Rect &other) const
+            {
+                return other.x0 >= x0 && other.x1 <= x1 && other.y0 >= y0 && other.y1 <= y1;
+            }
+
+            Rect united(const Rect &other) const
+            {
+                if (empty())
+                    return other;
+                if (other.empty())
+                    return *this;
+                return {std::min(x0, other.x0), std::min(y0, other.y0),
+                        std::max(x1, other.x1), std::max(y1, other.y1)};
+            }
+
+            Rect clipped(int width, int height) const
+            {
+                return {std::max(x0, 0), std::max(y0, 0),
+                        std::min(x1, width), std::min(y1, height)};
+            }
+        };
+
         template <PixelFormat PF,
                   size_t WIDTH,
                   size_t HEIGHT,
@@ -20,6 +64,8 @@ namespace dv
         {
         public:
             static constexpr PixelFormat pixel_format = PF;
+            static constexpr size_t image_width = WIDTH;
+            static constexpr size_t image_height = HEIGHT;
             using PixelT = typename PixelFormatTrait<PF>::type;
 
             PixelFormat format() const { return format_; }
@@ -172,6 +218,90 @@ namespace dv
         };
 
 
+        // 不拥有内存的图像视图，像素布局与 Image 相同，可直接指向外部缓冲（如 mmap 的文件）
+        template <PixelFormat PF,
+                  size_t WIDTH,
+                  size_t HEIGHT>
+        class ImageView : public ImageBase<PF, WIDTH, HEIGHT, ImageView<PF, WIDTH, HEIGHT>>
+        {
+        public:
+            static constexpr PixelFormat pixel_format = PF;
+
+            using PixelT = typename PixelFormatTrait<PF>::type;
+
+            ImageView() = default;
+            explicit ImageView(void *data) : data_(static_cast<PixelT *>(data)) {}
+
+            PixelT &get(size_t x, size_t y)
+            {
+                return data_[y * WIDTH + x];
+            }
+
+            const PixelT &get(size_t x, size_t y) const
+            {
+                return data_[y * WIDTH + x];
+            }
+
+            void* get_data_ptr() {
+                return static_cast<void*>(data_);
+            }
+
+            const void* get_data_ptr() const {
+                return static_cast<const void*>(data_);
+            }
+
+            const size_t get_data_size() const {
+                return sizeof(PixelT) * WIDTH * HEIGHT;
+            }
+
+            bool valid() const { return data_ != nullptr; }
+
+        private:
+            PixelT *data_ = nullptr;
+        };
+
+        template <size_t WIDTH, size_t HEIGHT>
+        class ImageView<PixelFormat::Binary, WIDTH, HEIGHT> : public ImageBase<PixelFormat::Binary, WIDTH, HEIGHT, ImageView<PixelFormat::Binary, WIDTH, HEIGHT>>
+        {
+        public:
+            using PixelT = typename PixelFormatTrait<PixelFormat::Binary>::type;
+            using Proxy = typename Image<PixelFormat::Binary, WIDTH, HEIGHT>::Proxy;
+
+            ImageView() = default;
+            explicit ImageView(void *data) : data_(static_cast<uint8_t *>(data)) {}
+
+            Proxy get(size_t x, size_t y) {
+                if (x >= WIDTH || y >= HEIGHT) {
+                    return Proxy(nullptr, 0, true);
+                }
+                size_t idx = y * WIDTH + x;
+                return Proxy(&data_[idx / 8], uint8_t(1u << (idx % 8)), false);
+            }
+
+            PixelT get(size_t x, size_t y) const {
+                if (x >= WIDTH || y >= HEIGHT) return PixelT{0};
+                size_t idx = y * WIDTH + x;
+                return (data_[idx / 8] & uint8_t(1u << (idx % 8))) ? PixelT{255} : PixelT{0};
+            }
+
+            void* get_data_ptr() {
+                return static_cast<void*>(data_);
+            }
+
+            const void* get_data_ptr() const {
+                return static_cast<const void*>(data_);
+            }
+
+            const size_t get_data_size() const {
+                return (WIDTH * HEIGHT + 7) / 8;
+            }
+
+            bool valid() const { return data_ != nullptr; }
+
+        private:
+            uint8_t *data_ = nullptr;
+        };
+
         template <typename T>
         struct is_image : std::false_type
         {
@@ -182,6 +312,27 @@ namespace dv
         {
         };
 
+        template <PixelFormat PF, size_t W, size_t H>
+        struct is_image<image::ImageView<PF, W, H>> : std::true_type
+        {
+        };
+
+        // 像素按行连续存放、可以用行指针直接写的图像（Binary 是打包位，平面存储等其他派生类不算）
+        template <typename T>
+        struct is_row_addressable : std::false_type
+        {
+        };
+
+        template <PixelFormat PF, size_t W, size_t H>
+        struct is_row_addressable<image::Image<PF, W, H>> : std::bool_constant<PF != PixelFormat::Binary>
+        {
+        };
+
+        template <PixelFormat PF, size_t W, size_t H>
+        struct is_row_addressable<image::ImageView<PF, W, H>> : std::bool_constant<PF != PixelFormat::Binary>
+        {
+        };
+
 
         template <typename from, typename to>
         inline void image_cast(const from &src, to &dst)
@@ -197,8 +348,22 @@ namespace dv
             }
         }
 
+        // RGB565 源且目标类型打开了 Rgb565Lut 时，每个像素一次查表
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT>
+        inline std::enable_if_t<Rgb565Lut<typename PixelFormatTrait<PF>::type>::enabled>
+        image_cast(const Image<PixelFormat::RGB565, WIDTH, HEIGHT> &src, Image<PF, WIDTH, HEIGHT> &dst)
+        {
+            const auto &table = Rgb565Lut<typename PixelFormatTrait<PF>::type>::table();
+            const uint16_t *in = static_cast<const uint16_t *>(src.get_data_ptr());
+            auto *out = static_cast<typename PixelFormatTrait<PF>::type *>(dst.get_data_ptr());
+            for (size_t i = 0; i < WIDTH * HEIGHT; ++i)
+            {
+                out[i] = table[in[i]];
+            }
+        }
+
         template <size_t WIDTH, size_t HEIGHT>
-        inline void raw_to_rgb565(uint8_t *src, Image<PixelFormat::RGB565, WIDTH, HEIGHT> &dst)
+        inline void raw_to_rgb565(const uint8_t *src, Image<PixelFormat::RGB565, WIDTH, HEIGHT> &dst)
         {
             for (size_t i = 0; i < WIDTH * HEIGHT * 2; i += 2)
             {
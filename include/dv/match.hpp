@@ -0,0 +1,468 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "dv/image.hpp"
+#include "dv/binaryzation.hpp"
+
+namespace dv
+{
+    namespace match
+    {
+        using namespace image;
+        using namespace pixel_format;
+
+#if defined(DV_INTEGER_ONLY)
+        // 整数构建：SAD 分数是整数，NCC 分数是 Q16 定点
+        using score_t = int64_t;
+        constexpr score_t NCC_ONE = 65536;
+#else
+        using score_t = float;
+        constexpr score_t NCC_ONE = 1.0f;
+#endif
+
+        // 模板左上角的位置；SAD 越小越好，NCC 在 [-NCC_ONE, NCC_ONE]，越大越好
+        struct MatchResult
+        {
+            int x;
+            int y;
+            score_t score;
+        };
+
+        // NCC = num / sqrt(var * tpl_var)，num = n * dot - s * tpl_sum，var = n * q - s * s。
+        // 同一次搜索中 tpl_var 不变，候选之间按 sign(num) * num^2 / var 交叉相乘比较：
+        // 128 位中间结果，没有除法和开方；模板像素数不超过 2^14（如 128x128）时不会溢出。
+        // var 为 0 的窗口分数为 0，记为 {0, 1}
+        struct NccCandidate_
+        {
+            int64_t num;
+            uint64_t var;
+        };
+
+        inline bool ncc_better_(const NccCandidate_ &a, const NccCandidate_ &b)
+        {
+            if ((a.num < 0) != (b.num < 0))
+                return b.num < 0;
+            const uint64_t abs_a = static_cast<uint64_t>(a.num < 0 ? -a.num : a.num);
+            const uint64_t abs_b = static_cast<uint64_t>(b.num < 0 ? -b.num : b.num);
+            uint64_t l_hi, l_lo, r_hi, r_lo;
+            binaryzation::square_mul_(abs_a, b.var, l_hi, l_lo);
+            binaryzation::square_mul_(abs_b, a.var, r_hi, r_lo);
+            if (a.num < 0)
+                return l_hi < r_hi || (l_hi == r_hi && l_lo < r_lo);
+            return l_hi > r_hi || (l_hi == r_hi && l_lo > r_lo);
+        }
+
+        inline float ncc_score_float(int64_t num, uint64_t var, uint64_t tpl_var)
+        {
+            const float den = static_cast<float>(var) * static_cast<float>(tpl_var);
+            return den > 0 ? static_cast<float>(num) / std::sqrt(den) : 0.0f;
+        }
+
+        // 向下取整的整数平方根
+        inline uint64_t isqrt_u64_(uint64_t v)
+        {
+            uint64_t r = 0;
+            uint64_t bit = uint64_t(1) << 62;
+            while (bit > v)
+                bit >>= 2;
+            for (; bit; bit >>= 2)
+            {
+                if (v >= r + bit)
+                {
+                    v -= r + bit;
+                    r = (r >> 1) + bit;
+                }
+                else
+                {
+                    r >>= 1;
+                }
+            }
+            return r;
+        }
+
+        // Q16 分数。两个方差各自左移偶数位到 >= 2^32 再开方，平方根至少 16 位有效位
+        inline int64_t ncc_score_fixed(int64_t num, uint64_t var, uint64_t tpl_var)
+        {
+            if (var == 0 || tpl_var == 0)
+                return 0;
+            int shift = 0;
+            while ((var >> 32) == 0)
+            {
+                var <<= 2;
+                shift++;
+            }
+            while ((tpl_var >> 32) == 0)
+            {
+                tpl_var <<= 2;
+                shift++;
+            }
+            const uint64_t den = (isqrt_u64_(var) * isqrt_u64_(tpl_var)) >> 16;
+            const int64_t score = (num * (int64_t(1) << shift)) / static_cast<int64_t>(den);
+            return score > 65536 ? 65536 : (score < -65536 ? -65536 : score);
+        }
+
+        // 只对每次搜索的最优候选调用一次
+        inline score_t ncc_score_(int64_t num, uint64_t var, uint64_t tpl_var)
+        {
+#if defined(DV_INTEGER_ONLY)
+            return ncc_score_fixed(num, var, tpl_var);
+#else
+            return ncc_score_float(num, var, tpl_var);
+#endif
+        }
+
+        // 一行的绝对差之和
+        inline uint32_t sad_row_(const uint8_t *a, const uint8_t *b, size_t n)
+        {
+            size_t i = 0;
+            uint32_t sum = 0;
+#if defined(__AVX2__)
+            __m256i acc = _mm256_setzero_si256();
+            for (; i + 32 <= n; i += 32)
+            {
+                acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)),
+                                                            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i))));
+            }
+            __m128i acc128 = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+            for (; i + 16 <= n; i += 16)
+            {
+                acc128 = _mm_add_epi64(acc128, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i)),
+                                                            _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i))));
+            }
+            sum = static_cast<uint32_t>(_mm_cvtsi128_si32(acc128) + _mm_cvtsi128_si32(_mm_srli_si128(acc128, 8)));
+#elif defined(__SSE2__)
+            __m128i acc = _mm_setzero_si128();
+            for (; i + 16 <= n; i += 16)
+            {
+                acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i)),
+                                                      _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i))));
+            }
+            sum = static_cast<uint32_t>(_mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_srli_si128(acc, 8)));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+            uint32x4_t acc = vdupq_n_u32(0);
+            for (; i + 16 <= n; i += 16)
+            {
+                uint16x8_t d = vpaddlq_u8(vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i)));
+                acc = vpadalq_u16(acc, d);
+            }
+            sum = vaddvq_u32(acc);
+#endif
+            for (; i < n; ++i)
+            {
+                sum += static_cast<uint32_t>(a[i] > b[i] ? a[i] - b[i] : b[i] - a[i]);
+            }
+            return sum;
+        }
+
+        // 一行的点积
+        inline uint32_t dot_row_(const uint8_t *a, const uint8_t *b, size_t n)
+        {
+            size_t i = 0;
+            uint32_t sum = 0;
+#if defined(__AVX2__)
+            __m256i acc = _mm256_setzero_si256();
+            for (; i + 16 <= n; i += 16)
+            {
+                __m256i va = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i)));
+                __m256i vb = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i)));
+                acc = _mm256_add_epi32(acc, _mm256_madd_epi16(va, vb));
+            }
+            __m128i acc128 = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+            acc128 = _mm_add_epi32(acc128, _mm_srli_si128(acc128, 8));
+            acc128 = _mm_add_epi32(acc128, _mm_srli_si128(acc128, 4));
+            sum = static_cast<uint32_t>(_mm_cvtsi128_si32(acc128));
+#elif defined(__SSE2__)
+            const __m128i zero = _mm_setzero_si128();
+            __m128i acc = _mm_setzero_si128();
+            for (; i + 16 <= n; i += 16)
+            {
+                __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+                __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+                acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpacklo_epi8(va, zero), _mm_unpacklo_epi8(vb, zero)));
+                acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpackhi_epi8(va, zero), _mm_unpackhi_epi8(vb, zero)));
+            }
+            acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 8));
+            acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 4));
+            sum = static_cast<uint32_t>(_mm_cvtsi128_si32(acc));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+            uint32x4_t acc = vdupq_n_u32(0);
+            for (; i + 16 <= n; i += 16)
+            {
+                uint8x16_t va = vld1q_u8(a + i);
+                uint8x16_t vb = vld1q_u8(b + i);
+                acc = vpadalq_u16(acc, vmull_u8(vget_low_u8(va), vget_low_u8(vb)));
+                acc = vpadalq_u16(acc, vmull_u8(vget_high_u8(va), vget_high_u8(vb)));
+            }
+            sum = vaddvq_u32(acc);
+#endif
+            for (; i < n; ++i)
+            {
+                sum += static_cast<uint32_t>(a[i]) * b[i];
+            }
+            return sum;
+        }
+
+        // 灰度的积分图和平方积分图，只在给定区域内计算。
+        // 用 uint32_t 保存并允许回绕：窗口和本身小于 2^32 时，模 2^32 的差仍然是正确结果。
+        template <size_t WIDTH, size_t HEIGHT>
+        class IntegralImage
+        {
+        public:
+            void compute(const uint8_t *img, size_t stride, const Rect &roi)
+            {
+                roi_ = roi;
+                const size_t w = static_cast<size_t>(roi.x1 - roi.x0);
+                const size_t h = static_cast<size_t>(roi.y1 - roi.y0);
+                stride_ = w + 1;
+                std::memset(sum_, 0, sizeof(uint32_t) * stride_);
+                std::memset(sqsum_, 0, sizeof(uint32_t) * stride_);
+                for (size_t y = 0; y < h; ++y)
+                {
+                    const uint8_t *row = img + (roi.y0 + y) * stride + roi.x0;
+                    uint32_t *s = sum_ + (y + 1) * stride_;
+                    uint32_t *q = sqsum_ + (y + 1) * stride_;
+                    const uint32_t *s_up = s - stride_;
+                    const uint32_t *q_up = q - stride_;
+                    uint32_t row_sum = 0, row_sq = 0;
+                    s[0] = 0;
+                    q[0] = 0;
+                    for (size_t x = 0; x < w; ++x)
+                    {
+                        row_sum += row[x];
+                        row_sq += static_cast<uint32_t>(row[x]) * row[x];
+                        s[x + 1] = s_up[x + 1] + row_sum;
+                        q[x + 1] = q_up[x + 1] + row_sq;
+                    }
+                }
+            }
+
+            // 图像坐标下的窗口 [x, x + w) x [y, y + h)，必须在 compute 的区域内
+            uint32_t sum(int x, int y, int w, int h) const
+            {
+                return window_(sum_, x, y, w, h);
+            }
+
+            uint32_t sqsum(int x, int y, int w, int h) const
+            {
+                return window_(sqsum_, x, y, w, h);
+            }
+
+        private:
+            uint32_t window_(const uint32_t *table, int x, int y, int w, int h) const
+            {
+                size_t x0 = static_cast<size_t>(x - roi_.x0), y0 = static_cast<size_t>(y - roi_.y0);
+                size_t x1 = x0 + w, y1 = y0 + h;
+                return table[y1 * stride_ + x1] - table[y0 * stride_ + x1] - table[y1 * stride_ + x0] + table[y0 * stride_ + x0];
+            }
+
+            Rect roi_{0, 0, 0, 0};
+            size_t stride_ = 0;
+            uint32_t sum_[(WIDTH + 1) * (HEIGHT + 1)];
+            uint32_t sqsum_[(WIDTH + 1) * (HEIGHT + 1)];
+        };
+
+        // 2x2 平均缩小一半（四舍五入）
+        inline void downsample2_(const uint8_t *src, size_t src_stride, size_t dst_width, size_t dst_height,
+                                 uint8_t *dst, size_t dst_stride)
+        {
+            for (size_t y = 0; y < dst_height; ++y)
+            {
+                const uint8_t *r0 = src + 2 * y * src_stride;
+                const uint8_t *r1 = r0 + src_stride;
+                uint8_t *out = dst + y * dst_stride;
+                for (size_t x = 0; x < dst_width; ++x)
+                {
+                    out[x] = static_cast<uint8_t>((r0[2 * x] + r0[2 * x + 1] + r1[2 * x] + r1[2 * x + 1] + 2) >> 2);
+                }
+            }
+        }
+
+        // 模板匹配：候选位置是模板完整落在 roi（与图像的交集）内的所有左上角。
+        // 粗到精模式先在半分辨率上全范围搜索，再在原分辨率的 ±REFINE 邻域内细化。
+        template <size_t WIDTH, size_t HEIGHT, size_t TW, size_t TH>
+        class TemplateMatcher
+        {
+            static_assert(TW * TH <= (1u << 14), "NCC candidate comparison needs at most 2^14 template pixels");
+
+        public:
+            static constexpr int REFINE = 2;
+
+            void set_template(const Image<PixelFormat::Grayscale, TW, TH> &tpl)
+            {
+                std::memcpy(tpl_, tpl.get_data_ptr(), TW * TH);
+                stats(tpl_, TW, TH, tpl_sum_, tpl_sqsum_);
+                downsample2_(tpl_, TW, TW / 2, TH / 2, tpl_half_, TW / 2);
+                stats(tpl_half_, TW / 2, TH / 2, half_sum_, half_sqsum_);
+            }
+
+            bool sad(const Image<PixelFormat::Grayscale, WIDTH, HEIGHT> &img, Rect roi, MatchResult &out)
+            {
+                roi = roi.clipped(WIDTH, HEIGHT);
+                return search_sad(data(img), WIDTH, tpl_, TW, TH, roi, out);
+            }
+
+            bool ncc(const Image<PixelFormat::Grayscale, WIDTH, HEIGHT> &img, Rect roi, MatchResult &out)
+            {
+                roi = roi.clipped(WIDTH, HEIGHT);
+                return search_ncc(data(img), WIDTH, integral_, tpl_, TW, TH, tpl_sum_, tpl_sqsum_, roi, out);
+            }
+
+            bool sad_coarse_to_fine(const Image<PixelFormat::Grayscale, WIDTH, HEIGHT> &img, Rect roi, MatchResult &out)
+            {
+                roi = roi.clipped(WIDTH, HEIGHT);
+                MatchResult coarse;
+                if (!prepare_coarse(img, roi) ||
+                    !search_sad(half_, WIDTH / 2, tpl_half_, TW / 2, TH / 2, half_roi(roi), coarse))
+                    return search_sad(data(img), WIDTH, tpl_, TW, TH, roi, out);
+                return search_sad(data(img), WIDTH, tpl_, TW, TH, refine_roi(coarse, roi), out);
+            }
+
+            bool ncc_coarse_to_fine(const Image<PixelFormat::Grayscale, WIDTH, HEIGHT> &img, Rect roi, MatchResult &out)
+            {
+                roi = roi.clipped(WIDTH, HEIGHT);
+                MatchResult coarse;
+                if (!prepare_coarse(img, roi) ||
+                    !search_ncc(half_, WIDTH / 2, half_integral_, tpl_half_, TW / 2, TH / 2, half_sum_, half_sqsum_,
+                                half_roi(roi), coarse))
+                    return search_ncc(data(img), WIDTH, integral_, tpl_, TW, TH, tpl_sum_, tpl_sqsum_, roi, out);
+                return search_ncc(data(img), WIDTH, integral_, tpl_, TW, TH, tpl_sum_, tpl_sqsum_,
+                                  refine_roi(coarse, roi), out);
+            }
+
+        private:
+            static const uint8_t *data(const Image<PixelFormat::Grayscale, WIDTH, HEIGHT> &img)
+            {
+                return static_cast<const uint8_t *>(img.get_data_ptr());
+            }
+
+            static void stats(const uint8_t *p, size_t w, size_t h, uint32_t &sum, uint32_t &sqsum)
+            {
+                sum = 0;
+                sqsum = 0;
+                for (size_t i = 0; i < w * h; ++i)
+                {
+                    sum += p[i];
+                    sqsum += static_cast<uint32_t>(p[i]) * p[i];
+                }
+            }
+
+            static Rect half_roi(const Rect &roi)
+            {
+                return {(roi.x0 + 1) / 2, (roi.y0 + 1) / 2, roi.x1 / 2, roi.y1 / 2};
+            }
+
+            static Rect refine_roi(const MatchResult &coarse, const Rect &roi)
+            {
+                Rect r{coarse.x * 2 - REFINE, coarse.y * 2 - REFINE,
+                       coarse.x * 2 + REFINE + static_cast<int>(TW) + 1, coarse.y * 2 + REFINE + static_cast<int>(TH) + 1};
+                return {std::max(r.x0, roi.x0), std::max(r.y0, roi.y0), std::min(r.x1, roi.x1), std::min(r.y1, roi.y1)};
+            }
+
+            // 只缩小 roi 覆盖的部分
+            bool prepare_coarse(const Image<PixelFormat::Grayscale, WIDTH, HEIGHT> &img, const Rect &roi)
+            {
+                if (TW < 4 || TH < 4)
+                    return false;
+                Rect h = half_roi(roi);
+                if (h.x1 - h.x0 < static_cast<int>(TW / 2) || h.y1 - h.y0 < static_cast<int>(TH / 2))
+                    return false;
+                downsample2_(data(img) + 2 * h.y0 * WIDTH + 2 * h.x0, WIDTH, h.x1 - h.x0, h.y1 - h.y0,
+                             half_ + h.y0 * (WIDTH / 2) + h.x0, WIDTH / 2);
+                return true;
+            }
+
+            static bool search_sad(const uint8_t *img, size_t stride, const uint8_t *tpl, size_t tw, size_t th,
+                                   const Rect &roi, MatchResult &out)
+            {
+                if (roi.x1 - roi.x0 < static_cast<int>(tw) || roi.y1 - roi.y0 < static_cast<int>(th))
+                    return false;
+                uint32_t best = UINT32_MAX;
+                out = MatchResult{roi.x0, roi.y0, static_cast<score_t>(best)};
+                for (int y = roi.y0; y + static_cast<int>(th) <= roi.y1; ++y)
+                {
+                    for (int x = roi.x0; x + static_cast<int>(tw) <= roi.x1; ++x)
+                    {
+                        const uint8_t *p = img + y * stride + x;
+                        uint32_t s = 0;
+                        // 已经超过当前最优就提前结束
+                        for (size_t ty = 0; ty < th && s < best; ++ty)
+                        {
+                            s += sad_row_(p + ty * stride, tpl + ty * tw, tw);
+                        }
+                        if (s < best)
+                        {
+                            best = s;
+                            out = MatchResult{x, y, static_cast<score_t>(s)};
+                        }
+                    }
+                }
+                return true;
+            }
+
+            template <typename Integral>
+            static bool search_ncc(const uint8_t *img, size_t stride, Integral &integral,
+                                   const uint8_t *tpl, size_t tw, size_t th, uint32_t tpl_sum, uint32_t tpl_sqsum,
+                                   const Rect &roi, MatchResult &out)
+            {
+                if (roi.x1 - roi.x0 < static_cast<int>(tw) || roi.y1 - roi.y0 < static_cast<int>(th))
+                    return false;
+                integral.compute(img, stride, roi);
+
+                const int64_t n = static_cast<int64_t>(tw * th);
+                const uint64_t tpl_var = static_cast<uint64_t>(n * tpl_sqsum - static_cast<int64_t>(tpl_sum) * tpl_sum);
+                NccCandidate_ best{0, 0};
+                out = MatchResult{roi.x0, roi.y0, 0};
+                for (int y = roi.y0; y + static_cast<int>(th) <= roi.y1; ++y)
+                {
+                    for (int x = roi.x0; x + static_cast<int>(tw) <= roi.x1; ++x)
+                    {
+                        const int64_t s = integral.sum(x, y, static_cast<int>(tw), static_cast<int>(th));
+                        const int64_t q = integral.sqsum(x, y, static_cast<int>(tw), static_cast<int>(th));
+                        NccCandidate_ c{0, 1};
+                        const uint64_t var = static_cast<uint64_t>(n * q - s * s);
+                        if (var > 0 && tpl_var > 0)
+                        {
+                            const uint8_t *p = img + y * stride + x;
+                            int64_t dot = 0;
+                            for (size_t ty = 0; ty < th; ++ty)
+                            {
+                                dot += dot_row_(p + ty * stride, tpl + ty * tw, tw);
+                            }
+                            c = NccCandidate_{n * dot - s * tpl_sum, var};
+                        }
+                        // 第一个候选就是 roi 左上角
+                        if (best.var == 0 || ncc_better_(c, best))
+                        {
+                            best = c;
+                            out.x = x;
+                            out.y = y;
+                        }
+                    }
+                }
+                out.score = ncc_score_(best.num, best.var, tpl_var);
+                return true;
+            }
+
+            uint8_t tpl_[TW * TH];
+            uint8_t tpl_half_[(TW / 2) * (TH / 2) + 1];
+            uint32_t tpl_sum_ = 0, tpl_sqsum_ = 0;
+            uint32_t half_sum_ = 0, half_sqsum_ = 0;
+
+            uint8_t half_[(WIDTH / 2) * (HEIGHT / 2)];
+            IntegralImage<WIDTH, HEIGHT> integral_;
+            IntegralImage<WIDTH / 2, HEIGHT / 2> half_integral_;
+        };
+
+    }
+}
@@ -0,0 +1,572 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include "dv/image.hpp"
+#include "dv/draw.hpp"
+
+namespace dv
+{
+    namespace overlay
+    {
+        using namespace image;
+        using namespace pixel_format;
+
+        enum class Shape : uint8_t
+        {
+            Point,
+            Line,
+            Rect,
+            FilledRect,
+            Circle,
+            FilledCircle,
+            Text,
+        };
+
+        // 稀疏的 HUD 图层：记录绘制命令，每个命令只在几何或文字变化时光栅化一次，
+        // 结果按行存成水平 span（只占被覆盖的像素，不保存整帧图层和掩码）。
+        // composite() 按命令顺序把 span 直接写到源图像上，避免整帧拷贝和重复光栅化；
+        // 输出缓冲跨帧保留时，composite_dirty() 只恢复并重画本帧脏矩形内的像素，跳过未变化的命令。
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT,
+                  size_t MAX_ITEMS = 32, size_t MAX_TEXT = 32, size_t MAX_DIRTY = 16, size_t MAX_SPANS = 4096>
+        class Overlay
+        {
+        public:
+            static_assert(WIDTH <= 32767 && HEIGHT <= 32767, "span coordinates are stored as int16_t");
+
+            using PixelT = typename PixelFormatTrait<PF>::type;
+            using Handle = int;
+
+            Handle point(int x, int y, PixelT color)
+            {
+                return add(Shape::Point, x, y, 0, 0, color);
+            }
+
+            Handle line(int x0, int y0, int x1, int y1, PixelT color)
+            {
+                return add(Shape::Line, x0, y0, x1, y1, color);
+            }
+
+            Handle rect(int x0, int y0, int x1, int y1, PixelT color)
+            {
+                return add(Shape::Rect, x0, y0, x1, y1, color);
+            }
+
+            Handle filled_rect(int x0, int y0, int x1, int y1, PixelT color)
+            {
+                return add(Shape::FilledRect, x0, y0, x1, y1, color);
+            }
+
+            Handle circle(int cx, int cy, int radius, PixelT color)
+            {
+                return add(Shape::Circle, cx, cy, radius, 0, color);
+            }
+
+            Handle filled_circle(int cx, int cy, int radius, PixelT color)
+            {
+                return add(Shape::FilledCircle, cx, cy, radius, 0, color);
+            }
+
+            Handle text(int x, int y, const char *str, PixelT color, int scale = 1)
+            {
+                Handle h = add(Shape::Text, x, y, scale, 0, color, str);
+                return h;
+            }
+
+            // 内容不变时不产生脏区域，每帧重复调用是廉价的
+            void set_text(Handle h, const char *str)
+            {
+                Item *item = get(h);
+                if (!item || item->shape != Shape::Text || std::strncmp(item->text, str, MAX_TEXT) == 0)
+                    return;
+                mark_dirty(*item);
+                copy_text(*item, str);
+                item->bounds = bounds_of(*item);
+                item->stale = true;
+                mark_dirty(*item);
+            }
+
+            void set_position(Handle h, int x, int y)
+            {
+                Item *item = get(h);
+                if (!item || (item->a == x && item->b == y))
+                    return;
+                mark_dirty(*item);
+                if (item->shape == Shape::Line || item->shape == Shape::Rect || item->shape == Shape::FilledRect)
+                {
+                    item->c += x - item->a;
+                    item->d += y - item->b;
+                }
+                item->a = x;
+                item->b = y;
+                item->bounds = bounds_of(*item);
+                item->stale = true;
+                mark_dirty(*item);
+            }
+
+            // 只改颜色不需要重新光栅化
+            void set_color(Handle h, PixelT color)
+            {
+                Item *item = get(h);
+                if (!item || std::memcmp(&item->color, &color, sizeof(PixelT)) == 0)
+                    return;
+                item->color = color;
+                mark_dirty(*item);
+            }
+
+            void set_visible(Handle h, bool visible)
+            {
+                Item *item = get(h);
+                if (!item || item->visible == visible)
+                    return;
+                item->visible = visible;
+                mark_dirty(*item, true);
+            }
+
+            void remove(Handle h)
+            {
+                Item *item = get(h);
+                if (!item)
+                    return;
+                mark_dirty(*item, true);
+                item->used = false;
+                item->span_count = 0;
+            }
+
+            void clear()
+            {
+                for (size_t i = 0; i < MAX_ITEMS; ++i)
+                    remove(static_cast<Handle>(i));
+            }
+
+            // 重新光栅化本帧变化的命令；dirty_rect() 可在之后查询本帧变化的区域
+            void update()
+            {
+                for (size_t i = 0; i < MAX_ITEMS; ++i)
+                {
+                    Item &item = items_[i];
+                    if (item.used && item.stale)
+                        rasterize(item);
+                }
+                frame_dirty_count_ = dirty_count_;
+                for (size_t d = 0; d < dirty_count_; ++d)
+                    frame_dirty_[d] = dirty_[d];
+                dirty_count_ = 0;
+            }
+
+            size_t dirty_count() const { return frame_dirty_count_; }
+            const Rect &dirty_rect(size_t i) const { return frame_dirty_[i]; }
+
+            // span 池中已使用的条目数（包括已失效、等待整理的条目）
+            size_t span_count() const { return span_used_; }
+
+            // 把图层中被覆盖的像素合成到 frame 上（通常就是处理完的源图像本身）
+            template <typename Derived>
+            void composite(ImageBase<PF, WIDTH, HEIGHT, Derived> &frame)
+            {
+                update();
+                for (size_t i = 0; i < MAX_ITEMS; ++i)
+                {
+                    const Item &item = items_[i];
+                    if (!item.used || !item.visible)
+                        continue;
+                    // span 池放不下的命令直接绘制
+                    if (item.direct)
+                    {
+                        draw_item(frame, item, item.color);
+                        continue;
+                    }
+                    // span 在光栅化时已经裁剪过，行连续的图像直接按行指针填充
+                    const Span *span = &spans_[item.span_begin];
+                    const Span *end = span + item.span_count;
+                    if constexpr (is_row_addressable<Derived>::value)
+                    {
+                        PixelT *data = static_cast<PixelT *>(frame.get_data_ptr());
+                        for (; span != end; ++span)
+                        {
+                            PixelT *row = data + size_t(span->y) * WIDTH;
+                            std::fill(row + span->x0, row + span->x1, item.color);
+                        }
+                    }
+                    else
+                    {
+                        for (; span != end; ++span)
+                            draw::hline(frame, span->x0, span->x1, span->y, item.color);
+                    }
+                }
+            }
+
+            // frame 保留着上一次合成的结果（例如显示缓冲），background 是未叠加图层的底图：
+            // 只把本帧脏矩形从 background 恢复到 frame，再重画与脏矩形相交的命令（裁剪到脏矩形内），
+            // 脏矩形之外的像素和不相交的命令都不动。结果与在 background 的副本上 composite() 相同。
+            template <typename Derived, typename BgDerived>
+            void composite_dirty(ImageBase<PF, WIDTH, HEIGHT, Derived> &frame,
+                                 const ImageBase<PF, WIDTH, HEIGHT, BgDerived> &background)
+            {
+                update();
+                for (size_t d = 0; d < frame_dirty_count_; ++d)
+                    restore(frame, background, frame_dirty_[d]);
+                for (size_t i = 0; i < MAX_ITEMS; ++i)
+                {
+                    const Item &item = items_[i];
+                    if (!item.used || !item.visible)
+                        continue;
+                    for (size_t d = 0; d < frame_dirty_count_; ++d)
+                    {
+                        const Rect &r = frame_dirty_[d];
+                        if (!item.bounds.intersects(r))
+                            continue;
+                        if (item.direct)
+                        {
+                            ClipWriter<Derived> clip(frame, r);
+                            draw_item(clip, item, item.color);
+                            continue;
+                        }
+                        const Span *span = &spans_[item.span_begin];
+                        for (size_t s = 0; s < item.span_count; ++s, ++span)
+                        {
+                            if (span->y >= r.y0 && span->y < r.y1)
+                                draw::hline(frame, std::max<int>(span->x0, r.x0), std::min<int>(span->x1, r.x1),
+                                            span->y, item.color);
+                        }
+                    }
+                }
+            }
+
+            // 不经过图层，直接把所有命令画到输出缓冲上
+            template <typename Derived>
+            void render(ImageBase<PF, WIDTH, HEIGHT, Derived> &frame) const
+            {
+                for (size_t i = 0; i < MAX_ITEMS; ++i)
+                {
+                    const Item &item = items_[i];
+                    if (item.used && item.visible)
+                        draw_item(frame, item, item.color);
+                }
+            }
+
+        private:
+            struct Span
+            {
+                int16_t y;
+                int16_t x0; // [x0, x1)
+                int16_t x1;
+            };
+
+            struct Item
+            {
+                bool used;
+                bool visible;
+                bool stale;  // 几何或文字变化后尚未重新光栅化
+                bool direct; // span 池放不下，合成时直接绘制
+                Shape shape;
+                int a;
+                int b;
+                int c;
+                int d;
+                PixelT color;
+                Rect bounds;
+                size_t span_begin;
+                size_t span_count;
+                char text[MAX_TEXT + 1];
+            };
+
+            // 光栅化用的“图像”：draw:: 写入的像素（已按图像边界裁剪）依次追加为 span，
+            // 同一行上相邻的像素并入上一个 span
+            class SpanWriter : public ImageBase<PF, WIDTH, HEIGHT, SpanWriter>
+            {
+            public:
+                struct Proxy
+                {
+                    SpanWriter *writer;
+                    int x;
+                    int y;
+
+                    Proxy &operator=(const PixelT &)
+                    {
+                        writer->push(x, y);
+                        return *this;
+                    }
+                };
+
+                SpanWriter(Span *spans, size_t capacity) : spans_(spans), capacity_(capacity) {}
+
+                Proxy get(size_t x, size_t y) { return Proxy{this, static_cast<int>(x), static_cast<int>(y)}; }
+                void *get_data_ptr() { return nullptr; }
+                const void *get_data_ptr() const { return nullptr; }
+                size_t get_data_size() const { return 0; }
+
+                size_t count() const { return count_; }
+                bool overflow() const { return overflow_; }
+
+            private:
+                void push(int x, int y)
+                {
+                    if (count_)
+                    {
+                        Span &last = spans_[count_ - 1];
+                        if (last.y == y && x >= last.x0 - 1 && x <= last.x1)
+                        {
+                            if (x == last.x1)
+                                last.x1++;
+                            else if (x == last.x0 - 1)
+                                last.x0--;
+                            return;
+                        }
+                    }
+                    if (count_ == capacity_)
+                    {
+                        overflow_ = true;
+                        return;
+                    }
+                    spans_[count_++] = Span{static_cast<int16_t>(y), static_cast<int16_t>(x), static_cast<int16_t>(x + 1)};
+                }
+
+                Span *spans_;
+                size_t capacity_;
+                size_t count_ = 0;
+                bool overflow_ = false;
+            };
+
+            // 直接绘制的命令在 composite_dirty() 中只能写到脏矩形内
+            template <typename Derived>
+            class ClipWriter : public ImageBase<PF, WIDTH, HEIGHT, ClipWriter<Derived>>
+            {
+            public:
+                struct Proxy
+                {
+                    ClipWriter *writer;
+                    int x;
+                    int y;
+
+                    Proxy &operator=(const PixelT &color)
+                    {
+                        const Rect &r = writer->rect_;
+                        if (x >= r.x0 && x < r.x1 && y >= r.y0 && y < r.y1)
+                            writer->frame_(x, y) = color;
+                        return *this;
+                    }
+                };
+
+                ClipWriter(ImageBase<PF, WIDTH, HEIGHT, Derived> &frame, const Rect &rect) : frame_(frame), rect_(rect) {}
+
+                Proxy get(size_t x, size_t y) { return Proxy{this, static_cast<int>(x), static_cast<int>(y)}; }
+                void *get_data_ptr() { return nullptr; }
+                const void *get_data_ptr() const { return nullptr; }
+                size_t get_data_size() const { return 0; }
+
+            private:
+                ImageBase<PF, WIDTH, HEIGHT, Derived> &frame_;
+                Rect rect_;
+            };
+
+            template <typename Derived, typename BgDerived>
+            static void restore(ImageBase<PF, WIDTH, HEIGHT, Derived> &frame,
+                                const ImageBase<PF, WIDTH, HEIGHT, BgDerived> &background, const Rect &r)
+            {
+                for (int y = r.y0; y < r.y1; ++y)
+                {
+                    if constexpr (is_row_addressable<Derived>::value && is_row_addressable<BgDerived>::value)
+                    {
+                        const PixelT *src = static_cast<const PixelT *>(background.get_data_ptr()) + size_t(y) * WIDTH;
+                        PixelT *dst = static_cast<PixelT *>(frame.get_data_ptr()) + size_t(y) * WIDTH;
+                        std::copy(src + r.x0, src + r.x1, dst + r.x0);
+                    }
+                    else
+                    {
+                        for (int x = r.x0; x < r.x1; ++x)
+                            frame(x, y) = background(x, y);
+                    }
+                }
+            }
+
+            Handle add(Shape shape, int a, int b, int c, int d, PixelT color, const char *str = nullptr)
+            {
+                for (size_t i = 0; i < MAX_ITEMS; ++i)
+                {
+                    Item &item = items_[i];
+                    if (item.used)
+                        continue;
+                    item.used = true;
+                    item.visible = true;
+                    item.stale = true;
+                    item.direct = false;
+                    item.shape = shape;
+                    item.a = a;
+                    item.b = b;
+                    item.c = c;
+                    item.d = d;
+                    item.color = color;
+                    item.span_begin = 0;
+                    item.span_count = 0;
+                    copy_text(item, str ? str : "");
+                    item.bounds = bounds_of(item);
+                    mark_dirty(item);
+                    return static_cast<Handle>(i);
+                }
+                return -1;
+            }
+
+            Item *get(Handle h)
+            {
+                if (h < 0 || static_cast<size_t>(h) >= MAX_ITEMS || !items_[h].used)
+                    return nullptr;
+                return &items_[h];
+            }
+
+            static void copy_text(Item &item, const char *str)
+            {
+                std::strncpy(item.text, str, MAX_TEXT);
+                item.text[MAX_TEXT] = '\0';
+            }
+
+            static Rect bounds_of(const Item &item)
+            {
+                switch (item.shape)
+                {
+                case Shape::Point:
+                    return {item.a, item.b, item.a + 1, item.b + 1};
+                case Shape::Line:
+                case Shape::Rect:
+                case Shape::FilledRect:
+                    return {std::min(item.a, item.c), std::min(item.b, item.d),
+                            std::max(item.a, item.c) + 1, std::max(item.b, item.d) + 1};
+                case Shape::Circle:
+                case Shape::FilledCircle:
+                    return {item.a - item.c, item.b - item.c, item.a + item.c + 1, item.b + item.c + 1};
+                case Shape::Text:
+                {
+                    using Font = draw::SimpleBitmapFont;
+                    int scale = item.c;
+                    int cols = 0, max_cols = 0, lines = 1;
+                    for (const char *p = item.text; *p != '\0'; ++p)
+                    {
+                        if (*p == '\n')
+                        {
+                            cols = 0;
+                            lines++;
+                            continue;
+                        }
+                        max_cols = std::max(max_cols, ++cols);
+                    }
+                    return {item.a, item.b,
+                            item.a + max_cols * (Font::char_width + 1) * scale,
+                            item.b + (lines - 1) * (Font::char_height + 1) * scale + Font::glyph_rows * scale};
+                }
+                }
+                return {0, 0, 0, 0};
+            }
+
+            void mark_dirty(const Item &item, bool force = false)
+            {
+                if (!force && !item.visible)
+                    return;
+                Rect r = item.bounds.clipped(static_cast<int>(WIDTH), static_cast<int>(HEIGHT));
+                if (r.empty())
+                    return;
+                for (size_t i = 0; i < dirty_count_; ++i)
+                {
+                    if (dirty_[i].intersects(r))
+                    {
+                        dirty_[i] = dirty_[i].united(r);
+                        return;
+                    }
+                }
+                if (dirty_count_ < MAX_DIRTY)
+                {
+                    dirty_[dirty_count_++] = r;
+                    return;
+                }
+                // 脏矩形数量用尽时并入最后一个
+                dirty_[MAX_DIRTY - 1] = dirty_[MAX_DIRTY - 1].united(r);
+            }
+
+            // 新的 span 追加在池末尾，放不下时先整理池再试一次
+            void rasterize(Item &item)
+            {
+                item.stale = false;
+                item.direct = false;
+                item.span_count = 0;
+                for (int attempt = 0; attempt < 2; ++attempt)
+                {
+                    SpanWriter writer(&spans_[span_used_], MAX_SPANS - span_used_);
+                    draw_item(writer, item, item.color);
+                    if (!writer.overflow())
+                    {
+                        item.span_begin = span_used_;
+                        item.span_count = writer.count();
+                        span_used_ += writer.count();
+                        return;
+                    }
+                    compact();
+                }
+                item.direct = true;
+            }
+
+            // 按 span 在池中的位置依次前移，去掉已失效的条目
+            void compact()
+            {
+                size_t used = 0;
+                size_t next = 0;
+                while (true)
+                {
+                    Item *first = nullptr;
+                    for (size_t i = 0; i < MAX_ITEMS; ++i)
+                    {
+                        Item &item = items_[i];
+                        if (item.used && item.span_count && item.span_begin >= next &&
+                            (!first || item.span_begin < first->span_begin))
+                            first = &item;
+                    }
+                    if (!first)
+                        break;
+                    next = first->span_begin + first->span_count;
+                    std::memmove(&spans_[used], &spans_[first->span_begin], first->span_count * sizeof(Span));
+                    first->span_begin = used;
+                    used += first->span_count;
+                }
+                span_used_ = used;
+            }
+
+            template <PixelFormat DPF, typename Derived, typename ColorT>
+            static void draw_item(ImageBase<DPF, WIDTH, HEIGHT, Derived> &img, const Item &item, ColorT color)
+            {
+                switch (item.shape)
+                {
+                case Shape::Point:
+                    draw::point(img, item.a, item.b, color);
+                    break;
+                case Shape::Line:
+                    draw::line(img, item.a, item.b, item.c, item.d, color);
+                    break;
+                case Shape::Rect:
+                    draw::rect(img, item.a, item.b, item.c, item.d, color);
+                    break;
+                case Shape::FilledRect:
+                    draw::filled_rect(img, item.a, item.b, item.c, item.d, color);
+                    break;
+                case Shape::Circle:
+                    draw::circle(img, item.a, item.b, item.c, color);
+                    break;
+                case Shape::FilledCircle:
+                    draw::filled_circle(img, item.a, item.b, item.c, color);
+                    break;
+                case Shape::Text:
+                    draw::text(img, item.a, item.b, item.text, color, item.c);
+                    break;
+                }
+            }
+
+            Item items_[MAX_ITEMS]{};
+            Rect dirty_[MAX_DIRTY]{};
+            size_t dirty_count_ = 0;
+            Rect frame_dirty_[MAX_DIRTY]{};
+            size_t frame_dirty_count_ = 0;
+            Span spans_[MAX_SPANS];
+            size_t span_used_ = 0;
+        };
+
+    }
+}
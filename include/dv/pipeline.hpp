@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "dv/image.hpp"
+
+namespace dv
+{
+    namespace pipeline
+    {
+        using namespace image;
+        using namespace pixel_format;
+
+        // 惰性像素流水线：每个阶段都是一个 ImageBase 派生的表达式，get(x, y) 时才按需计算，
+        // 例如 src | to<Grayscale>() | resize<160, 120>() | in_range(lo, hi)
+        // 只有 materialize() 写出最终结果，整条链在一个循环里完成，中间结果不落内存。
+        //
+        // 具体的 Image/ImageView 按引用保存，表达式本身按值保存（它们只包含引用和参数）。
+        template <typename T>
+        using stored_t = std::conditional_t<is_image<T>::value, const T &, T>;
+
+        template <typename Src, PixelFormat PF>
+        class CastExpr : public ImageBase<PF, Src::image_width, Src::image_height, CastExpr<Src, PF>>
+        {
+        public:
+            using PixelT = typename PixelFormatTrait<PF>::type;
+            // 与 image_cast 相同：RGB565 源且目标类型打开了 Rgb565Lut 时每个像素一次查表
+            static constexpr bool use_lut = Src::pixel_format == PixelFormat::RGB565 && Rgb565Lut<PixelT>::enabled;
+
+            explicit CastExpr(const Src &src) : src_(src)
+            {
+                if constexpr (use_lut)
+                    table_ = Rgb565Lut<PixelT>::table().data();
+            }
+
+            PixelT get(size_t x, size_t y) const
+            {
+                if constexpr (use_lut)
+                {
+                    const RGB565Pixel rgb565 = src_(x, y);
+                    uint16_t word;
+                    std::memcpy(&word, &rgb565, sizeof(word));
+                    return table_[word];
+                }
+                else
+                {
+                    PixelT pixel;
+                    pixel_cast(src_(x, y), pixel);
+                    return pixel;
+                }
+            }
+
+        private:
+            stored_t<Src> src_;
+            const PixelT *table_ = nullptr;
+        };
+
+        template <typename Src, size_t WIDTH, size_t HEIGHT>
+        class ResizeExpr : public ImageBase<Src::pixel_format, WIDTH, HEIGHT, ResizeExpr<Src, WIDTH, HEIGHT>>
+        {
+        public:
+            using PixelT = typename PixelFormatTrait<Src::pixel_format>::type;
+
+            explicit ResizeExpr(const Src &src) : src_(src) {}
+
+            // 与 interpolation::nearest_neighbor 相同的采样位置
+            PixelT get(size_t x, size_t y) const
+            {
+                return src_(x * Src::image_width / WIDTH, y * Src::image_height / HEIGHT);
+            }
+
+        private:
+            stored_t<Src> src_;
+        };
+
+        template <typename Src, typename TPFT>
+        class RangeExpr : public ImageBase<PixelFormat::Binary, Src::image_width, Src::image_height, RangeExpr<Src, TPFT>>
+        {
+        public:
+            using PixelT = typename PixelFormatTrait<PixelFormat::Binary>::type;
+
+            RangeExpr(const Src &src, TPFT t_low, TPFT t_high) : src_(src), t_low_(t_low), t_high_(t_high) {}
+
+            // 与 binaryzation::threshold 相同的判定
+            PixelT get(size_t x, size_t y) const
+            {
+                return test(x, y) ? BinaryPixel{255} : BinaryPixel{0};
+            }
+
+            bool test(size_t x, size_t y) const
+            {
+                TPFT pixel;
+                pixel_cast(src_(x, y), pixel);
+                return pixel_format::in_range(pixel, t_low_, t_high_);
+            }
+
+        private:
+            stored_t<Src> src_;
+            TPFT t_low_;
+            TPFT t_high_;
+        };
+
+        template <typename Src, PixelFormat PF, typename Fn>
+        class MapExpr : public ImageBase<PF, Src::image_width, Src::image_height, MapExpr<Src, PF, Fn>>
+        {
+        public:
+            using PixelT = typename PixelFormatTrait<PF>::type;
+
+            MapExpr(const Src &src, Fn fn) : src_(src), fn_(std::move(fn)) {}
+
+            PixelT get(size_t x, size_t y) const
+            {
+                return fn_(src_(x, y));
+            }
+
+        private:
+            stored_t<Src> src_;
+            Fn fn_;
+        };
+
+        // ------------------------------- 阶段 -------------------------------
+
+        template <PixelFormat PF>
+        struct ToStage
+        {
+        };
+
+        template <size_t WIDTH, size_t HEIGHT>
+        struct ResizeStage
+        {
+        };
+
+        template <typename TPFT>
+        struct RangeStage
+        {
+            TPFT t_low;
+            TPFT t_high;
+        };
+
+        template <PixelFormat PF, typename Fn>
+        struct MapStage
+        {
+            Fn fn;
+        };
+
+        template <PixelFormat PF>
+        constexpr ToStage<PF> to() { return {}; }
+
+        template <size_t WIDTH, size_t HEIGHT>
+        constexpr ResizeStage<WIDTH, HEIGHT> resize() { return {}; }
+
+        template <typename TPFT>
+        constexpr RangeStage<TPFT> in_range(TPFT t_low, TPFT t_high) { return {t_low, t_high}; }
+
+        // fn: 源像素 -> PixelFormatTrait<PF>::type
+        template <PixelFormat PF, typename Fn>
+        constexpr MapStage<PF, Fn> map(Fn fn) { return {std::move(fn)}; }
+
+        template <PixelFormat SPF, size_t W, size_t H, typename Derived, PixelFormat PF>
+        inline CastExpr<Derived, PF> operator|(const ImageBase<SPF, W, H, Derived> &src, ToStage<PF>)
+        {
+            return CastExpr<Derived, PF>(static_cast<const Derived &>(src));
+        }
+
+        template <PixelFormat SPF, size_t W, size_t H, typename Derived, size_t DW, size_t DH>
+        inline ResizeExpr<Derived, DW, DH> operator|(const ImageBase<SPF, W, H, Derived> &src, ResizeStage<DW, DH>)
+        {
+            return ResizeExpr<Derived, DW, DH>(static_cast<const Derived &>(src));
+        }
+
+        template <PixelFormat SPF, size_t W, size_t H, typename Derived, typename TPFT>
+        inline RangeExpr<Derived, TPFT> operator|(const ImageBase<SPF, W, H, Derived> &src, RangeStage<TPFT> stage)
+        {
+            return RangeExpr<Derived, TPFT>(static_cast<const Derived &>(src), stage.t_low, stage.t_high);
+        }
+
+        template <PixelFormat SPF, size_t W, size_t H, typename Derived, PixelFormat PF, typename Fn>
+        inline MapExpr<Derived, PF, Fn> operator|(const ImageBase<SPF, W, H, Derived> &src, MapStage<PF, Fn> stage)
+        {
+            return MapExpr<Derived, PF, Fn>(static_cast<const Derived &>(src), std::move(stage.fn));
+        }
+
+        // ---------------------------- 物化输出 ------------------------------
+
+        template <PixelFormat PF, size_t W, size_t H, typename Expr, typename DstDerived>
+        inline void materialize(const ImageBase<PF, W, H, Expr> &expr, ImageBase<PF, W, H, DstDerived> &dst)
+        {
+            const Expr &e = static_cast<const Expr &>(expr);
+            for (size_t y = 0; y < H; ++y)
+            {
+                for (size_t x = 0; x < W; ++x)
+                {
+                    dst(x, y) = e.get(x, y);
+                }
+            }
+        }
+
+        // 二值输出每 8 个像素拼成一个字节直接写入，不经过逐位的 Proxy
+        template <size_t W, size_t H, typename Expr, typename DstDerived>
+        inline void materialize(const ImageBase<PixelFormat::Binary, W, H, Expr> &expr,
+                                ImageBase<PixelFormat::Binary, W, H, DstDerived> &dst)
+        {
+            const Expr &e = static_cast<const Expr &>(expr);
+            uint8_t *bytes = static_cast<uint8_t *>(dst.get_data_ptr());
+            uint8_t acc = 0;
+            size_t idx = 0;
+            for (size_t y = 0; y < H; ++y)
+            {
+                for (size_t x = 0; x < W; ++x, ++idx)
+                {
+                    acc |= static_cast<uint8_t>((static_cast<uint8_t>(e.get(x, y).value) != 0) << (idx % 8));
+                    if (idx % 8 == 7)
+                    {
+                        bytes[idx / 8] = acc;
+                        acc = 0;
+                    }
+                }
+            }
+            if (idx % 8)
+                bytes[idx / 8] = acc;
+        }
+
+    }
+}
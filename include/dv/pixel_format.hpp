@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <cmath>
 #include <array>
+#include <cstring>
 
 namespace dv
 {
@@ -15,6 +16,10 @@ namespace dv
             RGB565,
             RGB,
             LAB,
+            YUV422,
+            BayerRGGB,
+            BayerBGGR,
+            HSV,
         };
 
         template <PixelFormat PF>
@@ -163,6 +168,163 @@ namespace dv
             }
         };
 
+        // YUYV 打包格式：每两个像素共享一组色度，偶数列的 c 是 U，奇数列的 c 是 V。
+        // Image<YUV422> 的内存布局与传感器输出的 YUYV 字节流完全相同。
+        struct YUV422Pixel
+        {
+            uint8_t y;
+            uint8_t c;
+        };
+
+        template <>
+        struct PixelFormatTrait<PixelFormat::YUV422>
+        {
+            using type = YUV422Pixel;
+        };
+
+        // 完整的 YUV 三元组，用于 YUV422 图像的阈值比较
+        struct YUVPixel
+        {
+            uint8_t y;
+            uint8_t u;
+            uint8_t v;
+
+            static constexpr YUVPixel min()
+            {
+                return {0, 0, 0};
+            }
+            static constexpr YUVPixel max()
+            {
+                return {255, 255, 255};
+            }
+
+            bool operator<=(const YUVPixel &other) const
+            {
+                return (y <= other.y) && (u <= other.u) && (v <= other.v);
+            }
+            bool operator>=(const YUVPixel &other) const
+            {
+                return (y >= other.y) && (u >= other.u) && (v >= other.v);
+            }
+        };
+
+        // Bayer 原始数据，每个像素一个 8 位采样，颜色由所在位置和排列方式决定
+        struct BayerPixel
+        {
+            uint8_t value;
+        };
+
+        template <>
+        struct PixelFormatTrait<PixelFormat::BayerRGGB>
+        {
+            using type = BayerPixel;
+        };
+
+        template <>
+        struct PixelFormatTrait<PixelFormat::BayerBGGR>
+        {
+            using type = BayerPixel;
+        };
+
+        // BT.601 全范围 YUV -> RGB，8 位定点
+        inline RGBPixel yuv_to_rgb(uint8_t y, uint8_t u, uint8_t v)
+        {
+            int d = static_cast<int>(u) - 128;
+            int e = static_cast<int>(v) - 128;
+            auto clamp = [](int c) -> uint8_t
+            { return static_cast<uint8_t>(c < 0 ? 0 : (c > 255 ? 255 : c)); };
+            return RGBPixel{clamp(y + ((359 * e + 128) >> 8)),
+                            clamp(y - ((88 * d + 183 * e + 128) >> 8)),
+                            clamp(y + ((454 * d + 128) >> 8))};
+        }
+
+        // 色相用 256 级表示一整圈（1 级约 1.41°），这样 uint8_t 的回绕就是色相环的回绕
+        struct HSVPixel
+        {
+            uint8_t h;
+            uint8_t s;
+            uint8_t v;
+
+            static constexpr HSVPixel min()
+            {
+                return {0, 0, 0};
+            }
+            static constexpr HSVPixel max()
+            {
+                return {255, 255, 255};
+            }
+
+            static constexpr uint8_t hue_from_degrees(int degrees)
+            {
+                return static_cast<uint8_t>(((degrees % 360 + 360) % 360 * 256 + 180) / 360);
+            }
+
+            bool operator<=(const HSVPixel &other) const
+            {
+                return (h <= other.h) && (s <= other.s) && (v <= other.v);
+            }
+            bool operator>=(const HSVPixel &other) const
+            {
+                return (h >= other.h) && (s >= other.s) && (v >= other.v);
+            }
+        };
+
+        template <>
+        struct PixelFormatTrait<PixelFormat::HSV>
+        {
+            using type = HSVPixel;
+        };
+
+        // 阈值判定的定制点，threshold 及流式/流水线版本都通过它比较
+        template <typename T>
+        inline bool in_range(const T &pixel, const T &t_low, const T &t_high)
+        {
+            return pixel >= t_low && pixel <= t_high;
+        }
+
+        // 色相按环形区间比较：t_low.h > t_high.h 时表示跨过 0 的区间（如 350°~10°），
+        // 利用 uint8_t 回绕，一次无分支的比较即可
+        inline bool in_range(const HSVPixel &pixel, const HSVPixel &t_low, const HSVPixel &t_high)
+        {
+            return (static_cast<uint8_t>(pixel.h - t_low.h) <= static_cast<uint8_t>(t_high.h - t_low.h)) &
+                   (pixel.s >= t_low.s) & (pixel.s <= t_high.s) &
+                   (pixel.v >= t_low.v) & (pixel.v <= t_high.v);
+        }
+
+        // 纯整数 RGB -> HSV
+        inline HSVPixel rgb_to_hsv(uint8_t r, uint8_t g, uint8_t b)
+        {
+            int max = r > g ? (r > b ? r : b) : (g > b ? g : b);
+            int min = r < g ? (r < b ? r : b) : (g < b ? g : b);
+            int delta = max - min;
+            if (delta == 0)
+                return HSVPixel{0, 0, static_cast<uint8_t>(max)};
+
+            uint8_t s = static_cast<uint8_t>((255 * delta + max / 2) / max);
+
+            // 六个扇区，每个扇区 256/6 级；sector 是扇区起点（以 1/6 圈为单位）
+            int sector, diff;
+            if (max == r)
+            {
+                sector = 0;
+                diff = static_cast<int>(g) - b;
+            }
+            else if (max == g)
+            {
+                sector = 2;
+                diff = static_cast<int>(b) - r;
+            }
+            else
+            {
+                sector = 4;
+                diff = static_cast<int>(r) - g;
+            }
+            // 加上一整圈保证分子非负
+            int num = ((sector + 6) * delta + diff) * 256;
+            int h = (num + 3 * delta) / (6 * delta);
+            return HSVPixel{static_cast<uint8_t>(h & 0xFF), s, static_cast<uint8_t>(max)};
+        }
+
         inline const auto rgb565_to_lab_lookup_tables_init_()
         {
             std::array<LABPixel, 65536> rgb565_to_lab_lookup_table;
@@ -237,7 +399,7 @@ namespace dv
 
         template<typename SRCT, typename DSTT>
         inline void pixel_cast(const SRCT&, DSTT&){
-            static_assert(false, "Unsupported pixel format conversion");
+            static_assert(sizeof(SRCT) == 0, "Unsupported pixel format conversion");
             // throw std::runtime_error("Unsupported pixel format conversion");
         }
 
@@ -263,19 +425,69 @@ namespace dv
             rgb565.b = static_cast<uint8_t>((rgb.b >> 3) & 0x1F);
         }
 
+        // 两种构建都使用随源码提交的表 rgb565_lab_table.inc（tools/gen_lab_table.cpp 用上面的浮点实现、
+        // 不做 FMA 合并生成），编译进只读数据：整数构建不需要浮点，浮点构建的结果也不随目标的 FMA 变化
+        inline const std::array<LABPixel, 65536> &rgb565_to_lab_lookup_table()
+        {
+            static constexpr std::array<LABPixel, 65536> table = {{
+#include "dv/rgb565_lab_table.inc"
+            }};
+            return table;
+        }
+
         template<>
         inline void pixel_cast(const RGB565Pixel &rgb565, LABPixel &lab)
         {
-            const static auto & rgb565_to_lab_lookup_table = rgb565_to_lab_lookup_tables_init_();
+            const static auto & rgb565_to_lab_lookup_table = dv::pixel_format::rgb565_to_lab_lookup_table();
 
             lab = rgb565_to_lab_lookup_table[*reinterpret_cast<const uint16_t *>(&rgb565)];
         }
 
+        // 非负 Q27 定点数按 IEEE 单精度舍入到 24 位有效位（就近舍入，平局取偶）
+        inline uint64_t round_to_float_(uint64_t v)
+        {
+            if ((v >> 24) == 0)
+                return v;
+            const int shift = 40 - __builtin_clzll(v);
+            const uint64_t half = uint64_t(1) << (shift - 1);
+            const uint64_t rem = v & ((half << 1) - 1);
+            v >>= shift;
+            if (rem > half || (rem == half && (v & 1)))
+                v++;
+            return v << shift;
+        }
+
+        // round(0.299f * r + 0.587f * g + 0.114f * b) 按单精度、不做 FMA 合并时的结果，纯整数计算。
+        // 三个 float 系数在 Q27 下是精确的整数，精确和离 .5 足够远时 float 的舍入误差（< 2^-15）
+        // 不影响结果，直接取整；否则按 float 的运算顺序逐步模拟单精度舍入。
+        inline uint8_t rgb_to_luma_fixed(uint8_t r, uint8_t g, uint8_t b)
+        {
+            constexpr uint64_t C_R = uint64_t(10032775) << 2; // 0.299f = 10032775 * 2^-25
+            constexpr uint64_t C_G = uint64_t(9848226) << 3;  // 0.587f = 9848226 * 2^-24
+            constexpr uint64_t C_B = uint64_t(15300821);      // 0.114f = 15300821 * 2^-27
+            constexpr uint64_t HALF = uint64_t(1) << 26;
+            const uint64_t exact = C_R * r + C_G * g + C_B * b;
+            const uint64_t frac = exact & (2 * HALF - 1);
+            if (frac + 4096 < HALF || frac > HALF + 4096)
+                return static_cast<uint8_t>((exact + HALF) >> 27);
+            uint64_t sum = round_to_float_(round_to_float_(C_R * r) + round_to_float_(C_G * g));
+            sum = round_to_float_(sum + round_to_float_(C_B * b));
+            return static_cast<uint8_t>((sum + HALF) >> 27);
+        }
+
+        // Rec. 601 亮度；按通道处理的路径（如平面存储）也调用它，保证结果一致。
+        // 两种构建都用整数版本：浮点公式在 FMA 目标上会被编译器合并成 fma，
+        // 结果随目标甚至内联位置变化（-ffp-contract=fast 是 GNU 模式的默认值）
+        inline uint8_t rgb_to_luma(uint8_t r, uint8_t g, uint8_t b)
+        {
+            return rgb_to_luma_fixed(r, g, b);
+        }
+
         template<>
         inline void pixel_cast(const RGBPixel &rgb, GrayscalePixel &gray)
         {
             // Using Rec. 601 luma formula
-            gray.value = static_cast<uint8_t>(std::round(0.299f * rgb.r + 0.587f * rgb.g + 0.114f * rgb.b));
+            gray.value = rgb_to_luma(rgb.r, rgb.g, rgb.b);
         }
 
         template<>
@@ -286,6 +498,141 @@ namespace dv
             pixel_cast(rgb, gray);
         }
 
+        // 8 位 RGB -> LAB 不经过 RGB565 量化：sRGB 线性化和 LAB 的 f(t) 各用一张小表（Q15），
+        // 其余是整数乘加。表在编译期用 constexpr 牛顿迭代算出，整数构建同样可用。
+        constexpr int RGB_LAB_Q = 15;
+        constexpr int RGB_LAB_F_BITS = 10; // f(t) 表在 [0, 1] 上的分段数 2^10，段内线性插值
+
+        struct RgbLabTables
+        {
+            uint16_t linear[256];
+            uint16_t f[(1 << RGB_LAB_F_BITS) + 1];
+        };
+
+        constexpr double root_(double y, int n)
+        {
+            if (y <= 0)
+                return 0;
+            double x = y > 1 ? y : 1;
+            for (int i = 0; i < 64; ++i)
+            {
+                double p = 1;
+                for (int k = 0; k < n - 1; ++k)
+                    p *= x;
+                x = ((n - 1) * x + y / p) / n;
+            }
+            return x;
+        }
+
+        constexpr RgbLabTables rgb_lab_tables_init_()
+        {
+            RgbLabTables t{};
+            for (int i = 0; i < 256; ++i)
+            {
+                double c = i / 255.0;
+                // ((c + 0.055) / 1.055)^2.4 = (base^12)^(1/5)
+                double base = (c + 0.055) / 1.055;
+                double base2 = base * base, base4 = base2 * base2;
+                double lin = c <= 0.04045 ? c / 12.92 : root_(base4 * base4 * base4, 5);
+                t.linear[i] = static_cast<uint16_t>(lin * (1 << RGB_LAB_Q) + 0.5);
+            }
+            const double delta = 6.0 / 29.0;
+            for (int i = 0; i <= (1 << RGB_LAB_F_BITS); ++i)
+            {
+                double v = static_cast<double>(i) / (1 << RGB_LAB_F_BITS);
+                double f = v > delta * delta * delta ? root_(v, 3) : v / (3 * delta * delta) + 4.0 / 29.0;
+                t.f[i] = static_cast<uint16_t>(f * (1 << RGB_LAB_Q) + 0.5);
+            }
+            return t;
+        }
+
+        inline constexpr RgbLabTables rgb_lab_tables = rgb_lab_tables_init_();
+
+        // Q15 四舍五入（远离 0），与浮点表的 std::round 一致
+        inline int round_q15_(int32_t v)
+        {
+            constexpr int32_t half = 1 << (RGB_LAB_Q - 1);
+            return v >= 0 ? (v + half) >> RGB_LAB_Q : -((-v + half) >> RGB_LAB_Q);
+        }
+
+        // t 为 Q30，[0, 1]
+        inline int32_t lab_f_fixed_(uint32_t t)
+        {
+            constexpr int SHIFT = 30 - RGB_LAB_F_BITS;
+            constexpr uint32_t ONE = uint32_t(1) << 30;
+            if (t >= ONE)
+                return rgb_lab_tables.f[1 << RGB_LAB_F_BITS];
+            uint32_t idx = t >> SHIFT;
+            int32_t frac = static_cast<int32_t>((t & ((uint32_t(1) << SHIFT) - 1)) >> (SHIFT - 16));
+            int32_t f0 = rgb_lab_tables.f[idx], f1 = rgb_lab_tables.f[idx + 1];
+            return f0 + (((f1 - f0) * frac + (1 << 15)) >> 16);
+        }
+
+        inline LABPixel rgb_to_lab(uint8_t r8, uint8_t g8, uint8_t b8)
+        {
+            // sRGB D65 矩阵的每一行已除以参考白，系数为 Q15，每行之和为 1
+            constexpr uint32_t X_R = 14219, X_G = 12328, X_B = 6221;
+            constexpr uint32_t Y_R = 6969, Y_G = 23434, Y_B = 2365;
+            constexpr uint32_t Z_R = 582, Z_G = 3587, Z_B = 28599;
+            const uint32_t r = rgb_lab_tables.linear[r8], g = rgb_lab_tables.linear[g8], b = rgb_lab_tables.linear[b8];
+            const int32_t fx = lab_f_fixed_(X_R * r + X_G * g + X_B * b);
+            const int32_t fy = lab_f_fixed_(Y_R * r + Y_G * g + Y_B * b);
+            const int32_t fz = lab_f_fixed_(Z_R * r + Z_G * g + Z_B * b);
+            return LABPixel{static_cast<int8_t>(round_q15_(116 * fy - (16 << RGB_LAB_Q))),
+                            static_cast<int8_t>(round_q15_(500 * (fx - fy))),
+                            static_cast<int8_t>(round_q15_(200 * (fy - fz)))};
+        }
+
+        // 8 位 RGB（YUV422、Bayer 去马赛克的结果）保留全部精度，不走 RGB565 表
+        template<>
+        inline void pixel_cast(const RGBPixel &rgb, LABPixel &lab)
+        {
+            lab = rgb_to_lab(rgb.r, rgb.g, rgb.b);
+        }
+
+        // 与 LAB 表相同，RGB565 字的高 5 位是 R
+        inline const auto rgb565_to_hsv_lookup_tables_init_()
+        {
+            std::array<HSVPixel, 65536> rgb565_to_hsv_lookup_table;
+            for (uint32_t i = 0; i <= 0xFFFF; ++i)
+            {
+                uint8_t r5 = (i >> 11) & 0x1F;
+                uint8_t g6 = (i >> 5) & 0x3F;
+                uint8_t b5 = i & 0x1F;
+                rgb565_to_hsv_lookup_table[i] = rgb_to_hsv(static_cast<uint8_t>((r5 * 255 + 15) / 31),
+                                                           static_cast<uint8_t>((g6 * 255 + 31) / 63),
+                                                           static_cast<uint8_t>((b5 * 255 + 15) / 31));
+            }
+            return rgb565_to_hsv_lookup_table;
+        }
+
+        inline const std::array<HSVPixel, 65536> &rgb565_to_hsv_lookup_table()
+        {
+            const static auto table = rgb565_to_hsv_lookup_tables_init_();
+            return table;
+        }
+
+        template<>
+        inline void pixel_cast(const RGB565Pixel &rgb565, HSVPixel &hsv)
+        {
+            const static auto & rgb565_to_hsv_lookup_table = dv::pixel_format::rgb565_to_hsv_lookup_table();
+
+            hsv = rgb565_to_hsv_lookup_table[*reinterpret_cast<const uint16_t *>(&rgb565)];
+        }
+
+        template<>
+        inline void pixel_cast(const RGBPixel &rgb, HSVPixel &hsv)
+        {
+            hsv = rgb_to_hsv(rgb.r, rgb.g, rgb.b);
+        }
+
+        // 亮度通道本身就是灰度
+        template<>
+        inline void pixel_cast(const YUV422Pixel &yuv, GrayscalePixel &gray)
+        {
+            gray.value = yuv.y;
+        }
+
         template<>
         inline void pixel_cast(const GrayscalePixel &gray, RGBPixel &rgb)
         {
@@ -299,5 +646,61 @@ namespace dv
             pixel_cast(gray, rgb);
             pixel_cast(rgb, rgb565);
         }
+
+        // RGB565 源的 65536 项转换表。默认关闭；对某个目标类型打开后，
+        // image::image_cast(Image<RGB565>, Image<...>) 每个像素只做一次查表。
+        // 打开方式：template <> struct Rgb565Lut<T> : Rgb565LutFromCast<T> {};
+        // 表在第一次使用时由 pixel_cast 逐项生成，结果与逐像素计算完全相同。
+        template <typename DSTT>
+        struct Rgb565Lut
+        {
+            static constexpr bool enabled = false;
+        };
+
+        template <typename DSTT>
+        inline std::array<DSTT, 65536> rgb565_lut_build_()
+        {
+            std::array<DSTT, 65536> table;
+            for (uint32_t i = 0; i <= 0xFFFF; ++i)
+            {
+                uint16_t word = static_cast<uint16_t>(i);
+                RGB565Pixel pixel;
+                std::memcpy(&pixel, &word, sizeof(word));
+                pixel_cast(pixel, table[i]);
+            }
+            return table;
+        }
+
+        template <typename DSTT>
+        struct Rgb565LutFromCast
+        {
+            static constexpr bool enabled = true;
+            static const std::array<DSTT, 65536> &table()
+            {
+                const static auto table = rgb565_lut_build_<DSTT>();
+                return table;
+            }
+        };
+
+        // 灰度需要浮点乘加和 round，64KB 的表明显更快
+        template <>
+        struct Rgb565Lut<GrayscalePixel> : Rgb565LutFromCast<GrayscalePixel>
+        {
+        };
+
+        // LAB/HSV 的 pixel_cast 本身就是查表，直接复用已有的表
+        template <>
+        struct Rgb565Lut<LABPixel>
+        {
+            static constexpr bool enabled = true;
+            static const std::array<LABPixel, 65536> &table() { return rgb565_to_lab_lookup_table(); }
+        };
+
+        template <>
+        struct Rgb565Lut<HSVPixel>
+        {
+            static constexpr bool enabled = true;
+            static const std::array<HSVPixel, 65536> &table() { return rgb565_to_hsv_lookup_table(); }
+        };
     }
 }
\ No newline at end of file
@@ -0,0 +1,504 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "dv/image.hpp"
+#include "dv/binaryzation.hpp"
+
+namespace dv
+{
+    namespace image
+    {
+        // 三通道格式的平面（SoA）存储：每个通道单独一个 32 字节对齐的平面，
+        // 按通道处理时是连续访问，便于 SIMD
+        template <PixelFormat PF>
+        struct PlanarTrait;
+
+        template <>
+        struct PlanarTrait<PixelFormat::RGB>
+        {
+            using ChannelT = uint8_t;
+            static constexpr bool hue_wrap = false;
+            static void split(const RGBPixel &p, ChannelT &c0, ChannelT &c1, ChannelT &c2)
+            {
+                c0 = p.r;
+                c1 = p.g;
+                c2 = p.b;
+            }
+            static RGBPixel merge(ChannelT c0, ChannelT c1, ChannelT c2) { return {c0, c1, c2}; }
+        };
+
+        template <>
+        struct PlanarTrait<PixelFormat::LAB>
+        {
+            using ChannelT = int8_t;
+            static constexpr bool hue_wrap = false;
+            static void split(const LABPixel &p, ChannelT &c0, ChannelT &c1, ChannelT &c2)
+            {
+                c0 = p.l;
+                c1 = p.a;
+                c2 = p.b;
+            }
+            static LABPixel merge(ChannelT c0, ChannelT c1, ChannelT c2) { return {c0, c1, c2}; }
+        };
+
+        template <>
+        struct PlanarTrait<PixelFormat::HSV>
+        {
+            using ChannelT = uint8_t;
+            static constexpr bool hue_wrap = true; // 通道 0（色相）按环形区间比较
+            static void split(const HSVPixel &p, ChannelT &c0, ChannelT &c1, ChannelT &c2)
+            {
+                c0 = p.h;
+                c1 = p.s;
+                c2 = p.v;
+            }
+            static HSVPixel merge(ChannelT c0, ChannelT c1, ChannelT c2) { return {c0, c1, c2}; }
+        };
+
+        template <PixelFormat PF,
+                  size_t WIDTH,
+                  size_t HEIGHT>
+        class PlanarImage : public ImageBase<PF, WIDTH, HEIGHT, PlanarImage<PF, WIDTH, HEIGHT>>
+        {
+        public:
+            static constexpr PixelFormat pixel_format = PF;
+            static constexpr size_t CHANNELS = 3;
+            // 平面长度向上取整到 32，SIMD 读尾部时不会越界
+            static constexpr size_t PLANE_SIZE = (WIDTH * HEIGHT + 31) / 32 * 32;
+
+            using PixelT = typename PixelFormatTrait<PF>::type;
+            using Trait = PlanarTrait<PF>;
+            using ChannelT = typename Trait::ChannelT;
+
+            class Proxy
+            {
+            public:
+                Proxy(PlanarImage *img, size_t idx) : img_(img), idx_(idx) {}
+
+                operator PixelT() const
+                {
+                    return img_->load(idx_);
+                }
+
+                Proxy &operator=(const PixelT &v)
+                {
+                    img_->store(idx_, v);
+                    return *this;
+                }
+
+                Proxy &operator=(const Proxy &other)
+                {
+                    return *this = static_cast<PixelT>(other);
+                }
+
+            private:
+                PlanarImage *img_;
+                size_t idx_;
+            };
+
+            Proxy get(size_t x, size_t y)
+            {
+                return Proxy(this, y * WIDTH + x);
+            }
+
+            PixelT get(size_t x, size_t y) const
+            {
+                return load(y * WIDTH + x);
+            }
+
+            ChannelT *plane(size_t c) { return planes_[c]; }
+            const ChannelT *plane(size_t c) const { return planes_[c]; }
+
+            void* get_data_ptr() {
+                return static_cast<void*>(planes_);
+            }
+
+            const void* get_data_ptr() const {
+                return static_cast<const void*>(planes_);
+            }
+
+            const size_t get_data_size() const {
+                return sizeof(planes_);
+            }
+
+            PixelT load(size_t idx) const
+            {
+                return Trait::merge(planes_[0][idx], planes_[1][idx], planes_[2][idx]);
+            }
+
+            void store(size_t idx, const PixelT &v)
+            {
+                Trait::split(v, planes_[0][idx], planes_[1][idx], planes_[2][idx]);
+            }
+
+        private:
+            alignas(32)
+            ChannelT planes_[CHANNELS][PLANE_SIZE]{};
+        };
+
+        template <PixelFormat PF, size_t W, size_t H>
+        struct is_image<image::PlanarImage<PF, W, H>> : std::true_type
+        {
+        };
+
+        // 3 字节像素拆成三个平面。x86 上字节重排需要 SSSE3 的 pshufb（AVX2 目标总是带 SSSE3），
+        // 只有 SSE2 时按字节处理；NEON 直接用 vld3q 解交错
+        inline void deinterleave3_(const uint8_t *in, uint8_t *c0, uint8_t *c1, uint8_t *c2, size_t n)
+        {
+            size_t i = 0;
+#if defined(__SSSE3__)
+            const __m128i m00 = _mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+            const __m128i m01 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1);
+            const __m128i m02 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13);
+            const __m128i m10 = _mm_setr_epi8(1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+            const __m128i m11 = _mm_setr_epi8(-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1);
+            const __m128i m12 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14);
+            const __m128i m20 = _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+            const __m128i m21 = _mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1);
+            const __m128i m22 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15);
+            for (; i + 16 <= n; i += 16)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 3 * i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 3 * i + 16));
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 3 * i + 32));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(c0 + i),
+                                 _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, m00), _mm_shuffle_epi8(b, m01)),
+                                              _mm_shuffle_epi8(c, m02)));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(c1 + i),
+                                 _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, m10), _mm_shuffle_epi8(b, m11)),
+                                              _mm_shuffle_epi8(c, m12)));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(c2 + i),
+                                 _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, m20), _mm_shuffle_epi8(b, m21)),
+                                              _mm_shuffle_epi8(c, m22)));
+            }
+#elif defined(__ARM_NEON)
+            for (; i + 16 <= n; i += 16)
+            {
+                const uint8x16x3_t v = vld3q_u8(in + 3 * i);
+                vst1q_u8(c0 + i, v.val[0]);
+                vst1q_u8(c1 + i, v.val[1]);
+                vst1q_u8(c2 + i, v.val[2]);
+            }
+#endif
+            for (; i < n; ++i)
+            {
+                c0[i] = in[3 * i];
+                c1[i] = in[3 * i + 1];
+                c2[i] = in[3 * i + 2];
+            }
+        }
+
+        // 三个平面合成 3 字节像素，deinterleave3_ 的逆操作
+        inline void interleave3_(const uint8_t *c0, const uint8_t *c1, const uint8_t *c2, uint8_t *out, size_t n)
+        {
+            size_t i = 0;
+#if defined(__SSSE3__)
+            const __m128i m00 = _mm_setr_epi8(0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5);
+            const __m128i m01 = _mm_setr_epi8(-1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1);
+            const __m128i m02 = _mm_setr_epi8(-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1);
+            const __m128i m10 = _mm_setr_epi8(-1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1);
+            const __m128i m11 = _mm_setr_epi8(5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10);
+            const __m128i m12 = _mm_setr_epi8(-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1);
+            const __m128i m20 = _mm_setr_epi8(-1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1);
+            const __m128i m21 = _mm_setr_epi8(-1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1);
+            const __m128i m22 = _mm_setr_epi8(10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15);
+            for (; i + 16 <= n; i += 16)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(c0 + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(c1 + i));
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(c2 + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 3 * i),
+                                 _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, m00), _mm_shuffle_epi8(b, m01)),
+                                              _mm_shuffle_epi8(c, m02)));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 3 * i + 16),
+                                 _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, m10), _mm_shuffle_epi8(b, m11)),
+                                              _mm_shuffle_epi8(c, m12)));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 3 * i + 32),
+                                 _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, m20), _mm_shuffle_epi8(b, m21)),
+                                              _mm_shuffle_epi8(c, m22)));
+            }
+#elif defined(__ARM_NEON)
+            for (; i + 16 <= n; i += 16)
+            {
+                uint8x16x3_t v;
+                v.val[0] = vld1q_u8(c0 + i);
+                v.val[1] = vld1q_u8(c1 + i);
+                v.val[2] = vld1q_u8(c2 + i);
+                vst3q_u8(out + 3 * i, v);
+            }
+#endif
+            for (; i < n; ++i)
+            {
+                out[3 * i] = c0[i];
+                out[3 * i + 1] = c1[i];
+                out[3 * i + 2] = c2[i];
+            }
+        }
+
+        // Q16 定点亮度：19595 r + 38470 g + 7471 b（系数和为 65536）。与 rgb_to_luma 的精确和
+        // 相差不超过 94/65536，再加上它模拟的 float 舍入误差 2/65536，所以小数部分离 .5 超过 128/65536 时
+        // 四舍五入结果与 rgb_to_luma 相同；一组里只要有像素落在这个窄带内，整组回退到 rgb_to_luma
+        // （纯整数，结果不随目标的 FMA 变化）。
+        constexpr uint32_t LUMA_Q16_R = 19595;
+        constexpr uint32_t LUMA_Q16_G = 38470;
+        constexpr uint32_t LUMA_Q16_B = 7471;
+        constexpr uint32_t LUMA_Q16_MARGIN = 128;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+        // 4 个像素的 Q16 亮度和，near 中累积落在 .5 附近的通道。
+        // pmaddwd 是有符号乘法，38470 按 int16 是 38470 - 65536，用 g << 16 补回
+        inline __m128i luma_q16_sse2_(__m128i rg, __m128i b0, __m128i g_hi, __m128i &near)
+        {
+            const __m128i k_rg = _mm_set1_epi32(static_cast<int>(LUMA_Q16_R | (LUMA_Q16_G << 16)));
+            const __m128i k_b = _mm_set1_epi32(static_cast<int>(LUMA_Q16_B));
+            const __m128i s = _mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(rg, k_rg), _mm_madd_epi16(b0, k_b)), g_hi);
+            const __m128i t = _mm_sub_epi32(_mm_and_si128(s, _mm_set1_epi32(0xFFFF)),
+                                            _mm_set1_epi32(32768 - static_cast<int>(LUMA_Q16_MARGIN)));
+            near = _mm_or_si128(near, _mm_andnot_si128(_mm_cmplt_epi32(t, _mm_setzero_si128()),
+                                                       _mm_cmplt_epi32(t, _mm_set1_epi32(2 * LUMA_Q16_MARGIN + 1))));
+            return _mm_srli_epi32(_mm_add_epi32(s, _mm_set1_epi32(32768)), 16);
+        }
+#endif
+
+        inline void planar_luma_(const uint8_t *r, const uint8_t *g, const uint8_t *b, uint8_t *out, size_t n)
+        {
+            size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 16 <= n; i += 16)
+            {
+                const __m128i r8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r + i));
+                const __m128i g8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(g + i));
+                const __m128i b8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+                __m128i y16[2];
+                __m128i near = zero;
+                for (int h = 0; h < 2; ++h)
+                {
+                    const __m128i r16 = h ? _mm_unpackhi_epi8(r8, zero) : _mm_unpacklo_epi8(r8, zero);
+                    const __m128i g16 = h ? _mm_unpackhi_epi8(g8, zero) : _mm_unpacklo_epi8(g8, zero);
+                    const __m128i b16 = h ? _mm_unpackhi_epi8(b8, zero) : _mm_unpacklo_epi8(b8, zero);
+                    const __m128i y0 = luma_q16_sse2_(_mm_unpacklo_epi16(r16, g16), _mm_unpacklo_epi16(b16, zero),
+                                                      _mm_unpacklo_epi16(zero, g16), near);
+                    const __m128i y1 = luma_q16_sse2_(_mm_unpackhi_epi16(r16, g16), _mm_unpackhi_epi16(b16, zero),
+                                                      _mm_unpackhi_epi16(zero, g16), near);
+                    y16[h] = _mm_packs_epi32(y0, y1);
+                }
+                if (_mm_movemask_epi8(near))
+                {
+                    for (size_t j = i; j < i + 16; ++j)
+                        out[j] = rgb_to_luma(r[j], g[j], b[j]);
+                    continue;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(y16[0], y16[1]));
+            }
+#elif defined(__ARM_NEON)
+            const uint32x4_t low_mask = vdupq_n_u32(0xFFFF);
+            const uint32x4_t half = vdupq_n_u32(32768);
+            const uint32x4_t margin = vdupq_n_u32(LUMA_Q16_MARGIN);
+            for (; i + 16 <= n; i += 16)
+            {
+                const uint8x16_t r8 = vld1q_u8(r + i);
+                const uint8x16_t g8 = vld1q_u8(g + i);
+                const uint8x16_t b8 = vld1q_u8(b + i);
+                const uint16x8_t r16[2] = {vmovl_u8(vget_low_u8(r8)), vmovl_u8(vget_high_u8(r8))};
+                const uint16x8_t g16[2] = {vmovl_u8(vget_low_u8(g8)), vmovl_u8(vget_high_u8(g8))};
+                const uint16x8_t b16[2] = {vmovl_u8(vget_low_u8(b8)), vmovl_u8(vget_high_u8(b8))};
+                uint32x4_t near = vdupq_n_u32(0);
+                uint16x4_t y[4];
+                for (int q = 0; q < 4; ++q)
+                {
+                    const uint16x4_t rq = q & 1 ? vget_high_u16(r16[q / 2]) : vget_low_u16(r16[q / 2]);
+                    const uint16x4_t gq = q & 1 ? vget_high_u16(g16[q / 2]) : vget_low_u16(g16[q / 2]);
+                    const uint16x4_t bq = q & 1 ? vget_high_u16(b16[q / 2]) : vget_low_u16(b16[q / 2]);
+                    uint32x4_t s = vmull_n_u16(rq, LUMA_Q16_R);
+                    s = vmlal_n_u16(s, gq, LUMA_Q16_G);
+                    s = vmlal_n_u16(s, bq, LUMA_Q16_B);
+                    near = vorrq_u32(near, vcleq_u32(vabdq_u32(vandq_u32(s, low_mask), half), margin));
+                    y[q] = vrshrn_n_u32(s, 16);
+                }
+                const uint32x2_t any = vorr_u32(vget_low_u32(near), vget_high_u32(near));
+                if (vget_lane_u32(any, 0) | vget_lane_u32(any, 1))
+                {
+                    for (size_t j = i; j < i + 16; ++j)
+                        out[j] = rgb_to_luma(r[j], g[j], b[j]);
+                    continue;
+                }
+                vst1q_u8(out + i, vcombine_u8(vmovn_u16(vcombine_u16(y[0], y[1])),
+                                              vmovn_u16(vcombine_u16(y[2], y[3]))));
+            }
+#endif
+            for (; i < n; ++i)
+            {
+                out[i] = rgb_to_luma(r[i], g[i], b[i]);
+            }
+        }
+
+        // 交错 -> 平面
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT>
+        inline void image_cast(const Image<PF, WIDTH, HEIGHT> &src, PlanarImage<PF, WIDTH, HEIGHT> &dst)
+        {
+            static_assert(sizeof(typename PixelFormatTrait<PF>::type) == 3, "planar formats are 3 bytes per pixel");
+            deinterleave3_(static_cast<const uint8_t *>(src.get_data_ptr()),
+                           reinterpret_cast<uint8_t *>(dst.plane(0)),
+                           reinterpret_cast<uint8_t *>(dst.plane(1)),
+                           reinterpret_cast<uint8_t *>(dst.plane(2)), WIDTH * HEIGHT);
+        }
+
+        // 平面 -> 交错
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT>
+        inline void image_cast(const PlanarImage<PF, WIDTH, HEIGHT> &src, Image<PF, WIDTH, HEIGHT> &dst)
+        {
+            static_assert(sizeof(typename PixelFormatTrait<PF>::type) == 3, "planar formats are 3 bytes per pixel");
+            interleave3_(reinterpret_cast<const uint8_t *>(src.plane(0)),
+                         reinterpret_cast<const uint8_t *>(src.plane(1)),
+                         reinterpret_cast<const uint8_t *>(src.plane(2)),
+                         static_cast<uint8_t *>(dst.get_data_ptr()), WIDTH * HEIGHT);
+        }
+
+        // 任意格式 -> 平面：逐像素 pixel_cast 后直接拆到各个平面
+        template <PixelFormat SPF, PixelFormat PF, size_t WIDTH, size_t HEIGHT>
+        inline void image_cast(const Image<SPF, WIDTH, HEIGHT> &src, PlanarImage<PF, WIDTH, HEIGHT> &dst)
+        {
+            using Trait = PlanarTrait<PF>;
+            const auto *in = static_cast<const typename PixelFormatTrait<SPF>::type *>(src.get_data_ptr());
+            auto *c0 = dst.plane(0);
+            auto *c1 = dst.plane(1);
+            auto *c2 = dst.plane(2);
+            for (size_t i = 0; i < WIDTH * HEIGHT; ++i)
+            {
+                typename PixelFormatTrait<PF>::type pixel;
+                pixel_cast(in[i], pixel);
+                Trait::split(pixel, c0[i], c1[i], c2[i]);
+            }
+        }
+
+        // 平面 RGB -> 灰度：定点 SIMD，结果与 pixel_cast(RGBPixel, GrayscalePixel) 逐位一致
+        template <size_t WIDTH, size_t HEIGHT>
+        inline void image_cast(const PlanarImage<PixelFormat::RGB, WIDTH, HEIGHT> &src,
+                               Image<PixelFormat::Grayscale, WIDTH, HEIGHT> &dst)
+        {
+            planar_luma_(src.plane(0), src.plane(1), src.plane(2), static_cast<uint8_t *>(dst.get_data_ptr()),
+                         WIDTH * HEIGHT);
+        }
+
+        // 三个平面同时做区间判定，结果按 Image<Binary> 的布局写成打包位。
+        // (x - lo) 按 uint8_t 回绕后 <= (hi - lo) 等价于 lo <= x <= hi（有符号通道同样成立），
+        // 色相通道 lo > hi 时自然就是跨 0 的环形区间。
+        inline void planar_range_mask_(const uint8_t *c0, const uint8_t *c1, const uint8_t *c2, size_t n,
+                                       const uint8_t lo[3], const uint8_t span[3], uint8_t *bits)
+        {
+            size_t i = 0;
+#if defined(__AVX2__)
+            const __m256i lo0 = _mm256_set1_epi8(static_cast<char>(lo[0]));
+            const __m256i lo1 = _mm256_set1_epi8(static_cast<char>(lo[1]));
+            const __m256i lo2 = _mm256_set1_epi8(static_cast<char>(lo[2]));
+            const __m256i sp0 = _mm256_set1_epi8(static_cast<char>(span[0]));
+            const __m256i sp1 = _mm256_set1_epi8(static_cast<char>(span[1]));
+            const __m256i sp2 = _mm256_set1_epi8(static_cast<char>(span[2]));
+            for (; i + 32 <= n; i += 32)
+            {
+                __m256i d0 = _mm256_sub_epi8(_mm256_load_si256(reinterpret_cast<const __m256i *>(c0 + i)), lo0);
+                __m256i d1 = _mm256_sub_epi8(_mm256_load_si256(reinterpret_cast<const __m256i *>(c1 + i)), lo1);
+                __m256i d2 = _mm256_sub_epi8(_mm256_load_si256(reinterpret_cast<const __m256i *>(c2 + i)), lo2);
+                __m256i m = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(d0, sp0), d0),
+                                             _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(d1, sp1), d1),
+                                                              _mm256_cmpeq_epi8(_mm256_min_epu8(d2, sp2), d2)));
+                uint32_t word = static_cast<uint32_t>(_mm256_movemask_epi8(m));
+                std::memcpy(bits + i / 8, &word, 4);
+            }
+#elif defined(__SSE2__)
+            const __m128i lo0 = _mm_set1_epi8(static_cast<char>(lo[0]));
+            const __m128i lo1 = _mm_set1_epi8(static_cast<char>(lo[1]));
+            const __m128i lo2 = _mm_set1_epi8(static_cast<char>(lo[2]));
+            const __m128i sp0 = _mm_set1_epi8(static_cast<char>(span[0]));
+            const __m128i sp1 = _mm_set1_epi8(static_cast<char>(span[1]));
+            const __m128i sp2 = _mm_set1_epi8(static_cast<char>(span[2]));
+            for (; i + 16 <= n; i += 16)
+            {
+                __m128i d0 = _mm_sub_epi8(_mm_load_si128(reinterpret_cast<const __m128i *>(c0 + i)), lo0);
+                __m128i d1 = _mm_sub_epi8(_mm_load_si128(reinterpret_cast<const __m128i *>(c1 + i)), lo1);
+                __m128i d2 = _mm_sub_epi8(_mm_load_si128(reinterpret_cast<const __m128i *>(c2 + i)), lo2);
+                __m128i m = _mm_and_si128(_mm_cmpeq_epi8(_mm_min_epu8(d0, sp0), d0),
+                                          _mm_and_si128(_mm_cmpeq_epi8(_mm_min_epu8(d1, sp1), d1),
+                                                        _mm_cmpeq_epi8(_mm_min_epu8(d2, sp2), d2)));
+                uint16_t word = static_cast<uint16_t>(_mm_movemask_epi8(m));
+                std::memcpy(bits + i / 8, &word, 2);
+            }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+            const uint8x16_t lo0 = vdupq_n_u8(lo[0]), lo1 = vdupq_n_u8(lo[1]), lo2 = vdupq_n_u8(lo[2]);
+            const uint8x16_t sp0 = vdupq_n_u8(span[0]), sp1 = vdupq_n_u8(span[1]), sp2 = vdupq_n_u8(span[2]);
+            static const uint8_t weights_data[8] = {1, 2, 4, 8, 16, 32, 64, 128};
+            const uint8x8_t weights = vld1_u8(weights_data);
+            for (; i + 16 <= n; i += 16)
+            {
+                uint8x16_t m = vandq_u8(vcleq_u8(vsubq_u8(vld1q_u8(c0 + i), lo0), sp0),
+                                        vandq_u8(vcleq_u8(vsubq_u8(vld1q_u8(c1 + i), lo1), sp1),
+                                                 vcleq_u8(vsubq_u8(vld1q_u8(c2 + i), lo2), sp2)));
+                bits[i / 8] = vaddv_u8(vand_u8(vget_low_u8(m), weights));
+                bits[i / 8 + 1] = vaddv_u8(vand_u8(vget_high_u8(m), weights));
+            }
+#endif
+            // 尾部（以及没有 SIMD 时的全部像素）逐字节处理；i 此时总是 8 的倍数
+            uint8_t acc = 0;
+            for (; i < n; ++i)
+            {
+                bool pass = static_cast<uint8_t>(c0[i] - lo[0]) <= span[0] &&
+                            static_cast<uint8_t>(c1[i] - lo[1]) <= span[1] &&
+                            static_cast<uint8_t>(c2[i] - lo[2]) <= span[2];
+                acc |= static_cast<uint8_t>(pass << (i % 8));
+                if (i % 8 == 7)
+                {
+                    bits[i / 8] = acc;
+                    acc = 0;
+                }
+            }
+            if (n % 8)
+                bits[n / 8] = acc;
+        }
+    }
+
+    namespace binaryzation
+    {
+        // 平面存储的阈值化走按通道的 SIMD 路径
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT>
+        inline void threshold(const PlanarImage<PF, WIDTH, HEIGHT> &src,
+                       Image<PixelFormat::Binary, WIDTH, HEIGHT> &dst,
+                       typename PixelFormatTrait<PF>::type t_low,
+                       typename PixelFormatTrait<PF>::type t_high)
+        {
+            using Trait = PlanarTrait<PF>;
+            using ChannelT = typename Trait::ChannelT;
+            ChannelT lo[3], hi[3];
+            Trait::split(t_low, lo[0], lo[1], lo[2]);
+            Trait::split(t_high, hi[0], hi[1], hi[2]);
+
+            uint8_t ulo[3], span[3];
+            for (int c = 0; c < 3; ++c)
+            {
+                // 非环形通道的空区间：没有像素能通过
+                if (!(Trait::hue_wrap && c == 0) && lo[c] > hi[c])
+                {
+                    std::memset(dst.get_data_ptr(), 0, dst.get_data_size());
+                    return;
+                }
+                ulo[c] = static_cast<uint8_t>(lo[c]);
+                span[c] = static_cast<uint8_t>(static_cast<uint8_t>(hi[c]) - static_cast<uint8_t>(lo[c]));
+            }
+
+            planar_range_mask_(reinterpret_cast<const uint8_t *>(src.plane(0)),
+                               reinterpret_cast<const uint8_t *>(src.plane(1)),
+                               reinterpret_cast<const uint8_t *>(src.plane(2)),
+                               WIDTH * HEIGHT, ulo, span, static_cast<uint8_t *>(dst.get_data_ptr()));
+        }
+    }
+}
@@ -0,0 +1,566 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "dv/image.hpp"
+
+namespace dv
+{
+    namespace recording
+    {
+        using namespace image;
+        using namespace pixel_format;
+
+        // 录像容器格式（主机字节序）：
+        //   FileHeader | frame 0 | frame 1 | ... | FrameIndex[frame_count]
+        // 每帧按 FRAME_ALIGN 对齐，内容与 Image::get_data_ptr() 的内存布局完全一致，
+        // 因此读取端可以直接把 mmap 的内存当作 ImageView 使用
+        constexpr char MAGIC[8] = {'D', 'V', 'R', 'E', 'C', '\0', '\0', '\0'};
+        constexpr uint32_t VERSION = 1;
+        constexpr size_t FRAME_ALIGN = 64;
+
+        struct FileHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t format;
+            uint32_t width;
+            uint32_t height;
+            uint32_t frame_bytes;
+            uint32_t frame_stride;
+            uint64_t frame_count;
+            uint64_t index_offset;
+            uint8_t reserved[16];
+        };
+        static_assert(sizeof(FileHeader) == 64, "FileHeader must stay 64 bytes");
+
+        struct FrameIndex
+        {
+            uint64_t offset;
+            uint64_t timestamp_us;
+        };
+
+        inline constexpr size_t align_up(size_t v, size_t a)
+        {
+            return (v + a - 1) / a * a;
+        }
+
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT>
+        inline FileHeader make_header_()
+        {
+            FileHeader header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = VERSION;
+            header.format = static_cast<uint32_t>(PF);
+            header.width = WIDTH;
+            header.height = HEIGHT;
+            header.frame_bytes = static_cast<uint32_t>(ImageView<PF, WIDTH, HEIGHT>().get_data_size());
+            header.frame_stride = static_cast<uint32_t>(align_up(header.frame_bytes, FRAME_ALIGN));
+            return header;
+        }
+
+        class RecordingWriter
+        {
+        public:
+            RecordingWriter() = default;
+            RecordingWriter(const RecordingWriter &) = delete;
+            RecordingWriter &operator=(const RecordingWriter &) = delete;
+            ~RecordingWriter() { close(); }
+
+            template <PixelFormat PF, size_t WIDTH, size_t HEIGHT>
+            bool open(const char *path)
+            {
+                close();
+                file_ = fopen(path, "wb");
+                if (!file_)
+                    return false;
+
+                header_ = make_header_<PF, WIDTH, HEIGHT>();
+                index_.clear();
+                offset_ = align_up(sizeof(FileHeader), FRAME_ALIGN);
+
+                // 先写占位头，close() 时回填帧数和索引位置
+                std::vector<uint8_t> pad(offset_, 0);
+                std::memcpy(pad.data(), &header_, sizeof(header_));
+                return fwrite(pad.data(), 1, pad.size(), file_) == pad.size();
+            }
+
+            template <typename ImageType>
+            bool write(const ImageType &img, uint64_t timestamp_us)
+            {
+                static_assert(is_image<ImageType>::value, "ImageType must be an Image");
+                if (!file_ || static_cast<uint32_t>(ImageType::pixel_format) != header_.format ||
+                    img.width() != header_.width || img.height() != header_.height)
+                    return false;
+
+                size_t size = img.get_data_size();
+                if (fwrite(img.get_data_ptr(), 1, size, file_) != size)
+                    return false;
+                static const uint8_t zeros[FRAME_ALIGN] = {0};
+                size_t pad = header_.frame_stride - size;
+                if (pad && fwrite(zeros, 1, pad, file_) != pad)
+                    return false;
+
+                index_.push_back(FrameIndex{offset_, timestamp_us});
+                offset_ += header_.frame_stride;
+                return true;
+            }
+
+            size_t frame_count() const { return index_.size(); }
+
+            bool close()
+            {
+                if (!file_)
+                    return true;
+                bool ok = true;
+                header_.frame_count = index_.size();
+                header_.index_offset = offset_;
+                if (!index_.empty())
+                    ok &= fwrite(index_.data(), sizeof(FrameIndex), index_.size(), file_) == index_.size();
+                ok &= fseek(file_, 0, SEEK_SET) == 0;
+                ok &= fwrite(&header_, sizeof(header_), 1, file_) == 1;
+                ok &= fclose(file_) == 0;
+                file_ = nullptr;
+                return ok;
+            }
+
+        private:
+            FILE *file_ = nullptr;
+            FileHeader header_{};
+            std::vector<FrameIndex> index_;
+            uint64_t offset_ = 0;
+        };
+
+        // 环满时的丢帧策略
+        enum class DropPolicy
+        {
+            Newest, // 丢弃新送来的帧
+            Oldest, // 丢弃队列中最旧的、还没开始写的帧，新帧复用它的槽
+        };
+
+        // 异步录像：write() 只把帧拷进预分配的环形槽，后台线程按批用 writev 一次写出多帧，
+        // 处理线程不会因为磁盘卡顿而阻塞；环满时按 DropPolicy 丢帧。文件格式与 RecordingWriter 相同。
+        // 写出走普通的带缓冲 fd（没有 O_DIRECT），对 I/O 没有对齐要求；文件内的帧位置按 FRAME_ALIGN 对齐。
+        // 槽在 open() 时一次分配并全部触碰一遍，录制过程中不再分配内存（帧索引除外，它在后台线程中增长）。
+        // write() 只能从一个线程调用。
+        class AsyncRecordingWriter
+        {
+        public:
+            static constexpr size_t RING_ALIGN = 4096;
+
+            AsyncRecordingWriter() = default;
+            AsyncRecordingWriter(const AsyncRecordingWriter &) = delete;
+            AsyncRecordingWriter &operator=(const AsyncRecordingWriter &) = delete;
+            ~AsyncRecordingWriter() { close(); }
+
+            // ring_frames: 环中的槽数；batch_frames: 后台线程每次最多写出的帧数
+            template <PixelFormat PF, size_t WIDTH, size_t HEIGHT>
+            bool open(const char *path, size_t ring_frames = 16, DropPolicy policy = DropPolicy::Newest,
+                      size_t batch_frames = 8)
+            {
+                close();
+                if (ring_frames == 0 || batch_frames == 0)
+                    return false;
+                fd_ = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+                if (fd_ < 0)
+                    return false;
+
+                header_ = make_header_<PF, WIDTH, HEIGHT>();
+                capacity_ = ring_frames;
+                batch_ = batch_frames < ring_frames ? batch_frames : ring_frames;
+                policy_ = policy;
+                void *ring = nullptr;
+                if (posix_memalign(&ring, RING_ALIGN, align_up(capacity_ * header_.frame_stride, RING_ALIGN)) != 0)
+                {
+                    ::close(fd_);
+                    fd_ = -1;
+                    return false;
+                }
+                ring_ = static_cast<uint8_t *>(ring);
+                // 槽尾的填充保持为 0，同时让所有页提前映射
+                std::memset(ring_, 0, capacity_ * header_.frame_stride);
+                timestamps_.assign(capacity_, 0);
+                queue_.assign(capacity_, 0);
+                free_.resize(capacity_);
+                for (size_t i = 0; i < capacity_; ++i)
+                    free_[i] = static_cast<uint32_t>(capacity_ - 1 - i);
+                queue_head_ = queue_count_ = 0;
+                index_.clear();
+                offset_ = align_up(sizeof(FileHeader), FRAME_ALIGN);
+                accepted_ = written_ = dropped_ = 0;
+                stop_ = failed_ = false;
+
+                // 先写占位头，close() 时回填帧数和索引位置
+                std::vector<uint8_t> pad(offset_, 0);
+                std::memcpy(pad.data(), &header_, sizeof(header_));
+                if (!write_all_(pad.data(), pad.size()))
+                {
+                    release_();
+                    return false;
+                }
+                thread_ = std::thread(&AsyncRecordingWriter::run_, this);
+                return true;
+            }
+
+            // 帧被接收（拷进环中）时返回 true，丢弃时返回 false；不等待磁盘
+            template <typename ImageType>
+            bool write(const ImageType &img, uint64_t timestamp_us)
+            {
+                static_assert(is_image<ImageType>::value, "ImageType must be an Image");
+                if (static_cast<uint32_t>(ImageType::pixel_format) != header_.format ||
+                    img.width() != header_.width || img.height() != header_.height)
+                    return false;
+                return write_raw(img.get_data_ptr(), timestamp_us);
+            }
+
+            // 已经打包好的一帧（如逐行流式处理得到的二值掩码），布局须与 Image<PF, WIDTH, HEIGHT> 相同
+            bool write_raw(const void *frame, uint64_t timestamp_us)
+            {
+                if (!thread_.joinable())
+                    return false;
+                uint32_t slot;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (failed_)
+                    {
+                        dropped_++;
+                        return false;
+                    }
+                    if (!free_.empty())
+                    {
+                        slot = free_.back();
+                        free_.pop_back();
+                    }
+                    else if (policy_ == DropPolicy::Oldest && queue_count_ > 0)
+                    {
+                        slot = queue_[queue_head_];
+                        queue_head_ = (queue_head_ + 1) % capacity_;
+                        queue_count_--;
+                        dropped_++;
+                    }
+                    else
+                    {
+                        // 所有槽都在写入中
+                        dropped_++;
+                        return false;
+                    }
+                }
+                // 槽已经从空闲表/队列中取出，拷贝时不需要持锁
+                std::memcpy(ring_ + size_t(slot) * header_.frame_stride, frame, header_.frame_bytes);
+                timestamps_[slot] = timestamp_us;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    queue_[(queue_head_ + queue_count_) % capacity_] = slot;
+                    queue_count_++;
+                }
+                accepted_++;
+                cv_.notify_one();
+                return true;
+            }
+
+            // 写完队列中剩余的帧，再写索引并回填文件头
+            bool close()
+            {
+                if (fd_ < 0)
+                    return true;
+                if (thread_.joinable())
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        stop_ = true;
+                    }
+                    cv_.notify_one();
+                    thread_.join();
+                }
+                bool ok = !failed_;
+                header_.frame_count = index_.size();
+                header_.index_offset = offset_;
+                if (!index_.empty())
+                    ok &= write_all_(index_.data(), sizeof(FrameIndex) * index_.size());
+                ok &= pwrite(fd_, &header_, sizeof(header_), 0) == static_cast<ssize_t>(sizeof(header_));
+                ok &= release_();
+                return ok;
+            }
+
+            bool is_open() const { return fd_ >= 0; }
+            // 接收进环的帧数（包括之后被 DropPolicy::Oldest 挤掉的）
+            uint64_t accepted() const { return accepted_; }
+            // 当前在环中等待写出的帧数
+            size_t queued() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return queue_count_;
+            }
+            uint64_t written() const { return written_; }
+            // 被拒绝、被挤掉或写入失败的帧数；close() 之后 written() + dropped() 等于 write() 的调用次数
+            uint64_t dropped() const { return dropped_; }
+            bool failed() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return failed_;
+            }
+
+        private:
+            void run_()
+            {
+                std::vector<uint32_t> batch(batch_);
+                std::vector<iovec> iov(batch_);
+                std::unique_lock<std::mutex> lock(mutex_);
+                while (true)
+                {
+                    cv_.wait(lock, [this]
+                             { return stop_ || queue_count_ > 0; });
+                    if (queue_count_ == 0)
+                        break;
+
+                    const size_t n = queue_count_ < batch_ ? queue_count_ : batch_;
+                    for (size_t i = 0; i < n; ++i)
+                        batch[i] = queue_[(queue_head_ + i) % capacity_];
+                    queue_head_ = (queue_head_ + n) % capacity_;
+                    queue_count_ -= n;
+                    const bool failed = failed_;
+                    lock.unlock();
+
+                    bool ok = false;
+                    if (!failed)
+                    {
+                        for (size_t i = 0; i < n; ++i)
+                        {
+                            iov[i].iov_base = ring_ + size_t(batch[i]) * header_.frame_stride;
+                            iov[i].iov_len = header_.frame_stride;
+                        }
+                        ok = writev_all_(iov.data(), n);
+                        if (ok)
+                        {
+                            for (size_t i = 0; i < n; ++i)
+                            {
+                                index_.push_back(FrameIndex{offset_, timestamps_[batch[i]]});
+                                offset_ += header_.frame_stride;
+                            }
+                        }
+                    }
+
+                    lock.lock();
+                    for (size_t i = 0; i < n; ++i)
+                        free_.push_back(batch[i]);
+                    if (ok)
+                        written_ += n;
+                    else
+                    {
+                        failed_ = true;
+                        dropped_ += n;
+                    }
+                }
+            }
+
+            bool write_all_(const void *data, size_t size)
+            {
+                iovec iov{const_cast<void *>(data), size};
+                return writev_all_(&iov, 1);
+            }
+
+            // 处理部分写入和 EINTR
+            bool writev_all_(iovec *iov, size_t count)
+            {
+                while (count)
+                {
+                    ssize_t n = ::writev(fd_, iov, static_cast<int>(count));
+                    if (n < 0)
+                    {
+                        if (errno == EINTR)
+                            continue;
+                        return false;
+                    }
+                    size_t done = static_cast<size_t>(n);
+                    while (count && done >= iov->iov_len)
+                    {
+                        done -= iov->iov_len;
+                        ++iov;
+                        --count;
+                    }
+                    if (count)
+                    {
+                        iov->iov_base = static_cast<uint8_t *>(iov->iov_base) + done;
+                        iov->iov_len -= done;
+                    }
+                }
+                return true;
+            }
+
+            bool release_()
+            {
+                bool ok = ::close(fd_) == 0;
+                fd_ = -1;
+                std::free(ring_);
+                ring_ = nullptr;
+                return ok;
+            }
+
+            int fd_ = -1;
+            FileHeader header_{};
+            DropPolicy policy_ = DropPolicy::Newest;
+            size_t capacity_ = 0;
+            size_t batch_ = 0;
+
+            uint8_t *ring_ = nullptr;
+            std::vector<uint64_t> timestamps_;
+            std::vector<uint32_t> queue_; // 按到达顺序排队的槽号
+            size_t queue_head_ = 0;
+            size_t queue_count_ = 0;
+            std::vector<uint32_t> free_;
+
+            // 只由后台线程访问，close() 在线程结束后使用
+            std::vector<FrameIndex> index_;
+            uint64_t offset_ = 0;
+
+            mutable std::mutex mutex_;
+            std::condition_variable cv_;
+            std::thread thread_;
+            bool stop_ = false;
+            bool failed_ = false;
+            std::atomic<uint64_t> accepted_{0};
+            std::atomic<uint64_t> written_{0};
+            std::atomic<uint64_t> dropped_{0};
+        };
+
+        // 以 mmap 方式打开录像，frame() 返回直接指向文件映射的零拷贝 ImageView。
+        // 映射为 MAP_PRIVATE，对视图的写入是写时复制，不会改动文件。
+        class RecordingReader
+        {
+        public:
+            RecordingReader() = default;
+            RecordingReader(const RecordingReader &) = delete;
+            RecordingReader &operator=(const RecordingReader &) = delete;
+            ~RecordingReader() { close(); }
+
+            bool open(const char *path)
+            {
+                close();
+                int fd = ::open(path, O_RDONLY);
+                if (fd < 0)
+                    return false;
+                struct stat st;
+                if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader))
+                {
+                    ::close(fd);
+                    return false;
+                }
+                size_ = static_cast<size_t>(st.st_size);
+                void *base = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                ::close(fd);
+                if (base == MAP_FAILED)
+                {
+                    size_ = 0;
+                    return false;
+                }
+                base_ = static_cast<uint8_t *>(base);
+                madvise(base_, size_, MADV_SEQUENTIAL);
+
+                std::memcpy(&header_, base_, sizeof(header_));
+                if (!validate())
+                {
+                    close();
+                    return false;
+                }
+                index_ = reinterpret_cast<const FrameIndex *>(base_ + header_.index_offset);
+                return true;
+            }
+
+            void close()
+            {
+                if (base_)
+                    munmap(base_, size_);
+                base_ = nullptr;
+                index_ = nullptr;
+                size_ = 0;
+                std::memset(&header_, 0, sizeof(header_));
+            }
+
+            bool is_open() const { return base_ != nullptr; }
+            size_t frame_count() const { return header_.frame_count; }
+            PixelFormat format() const { return static_cast<PixelFormat>(header_.format); }
+            size_t width() const { return header_.width; }
+            size_t height() const { return header_.height; }
+
+            uint64_t timestamp(size_t i) const
+            {
+                return i < header_.frame_count ? index_[i].timestamp_us : 0;
+            }
+
+            template <PixelFormat PF, size_t WIDTH, size_t HEIGHT>
+            bool compatible() const
+            {
+                return is_open() && header_.format == static_cast<uint32_t>(PF) &&
+                       header_.width == WIDTH && header_.height == HEIGHT &&
+                       header_.frame_bytes == ImageView<PF, WIDTH, HEIGHT>().get_data_size();
+            }
+
+            template <PixelFormat PF, size_t WIDTH, size_t HEIGHT>
+            bool frame(size_t i, ImageView<PF, WIDTH, HEIGHT> &view) const
+            {
+                if (i >= header_.frame_count || !compatible<PF, WIDTH, HEIGHT>())
+                    return false;
+                view = ImageView<PF, WIDTH, HEIGHT>(base_ + index_[i].offset);
+                return true;
+            }
+
+            // 提前让内核把第 i 帧读入页缓存
+            void prefetch(size_t i) const
+            {
+                if (i >= header_.frame_count)
+                    return;
+                const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+                size_t begin = index_[i].offset / page * page;
+                size_t end = index_[i].offset + header_.frame_bytes;
+                madvise(base_ + begin, end - begin, MADV_WILLNEED);
+            }
+
+        private:
+            bool validate() const
+            {
+                if (std::memcmp(header_.magic, MAGIC, sizeof(MAGIC)) != 0 || header_.version != VERSION)
+                    return false;
+                if (header_.frame_bytes == 0 || header_.frame_stride < header_.frame_bytes)
+                    return false;
+                if (header_.index_offset > size_ ||
+                    header_.frame_count > (size_ - header_.index_offset) / sizeof(FrameIndex))
+                    return false;
+                if (header_.index_offset % alignof(FrameIndex) != 0 || header_.frame_bytes > header_.index_offset)
+                    return false;
+                // offset + frame_bytes 对损坏的偏移（接近 2^64）会回绕，改为和 index_offset - frame_bytes 比较
+                const uint64_t last_offset = header_.index_offset - header_.frame_bytes;
+                auto index = reinterpret_cast<const FrameIndex *>(base_ + header_.index_offset);
+                for (size_t i = 0; i < header_.frame_count; ++i)
+                {
+                    if (index[i].offset % FRAME_ALIGN != 0 ||
+                        index[i].offset < align_up(sizeof(FileHeader), FRAME_ALIGN) ||
+                        index[i].offset > last_offset)
+                        return false;
+                }
+                return true;
+            }
+
+            uint8_t *base_ = nullptr;
+            size_t size_ = 0;
+            FileHeader header_{};
+            const FrameIndex *index_ = nullptr;
+        };
+
+    }
+}
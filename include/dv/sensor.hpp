@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "dv/image.hpp"
+
+namespace dv
+{
+    namespace sensor
+    {
+        using namespace image;
+        using namespace pixel_format;
+
+        // 传感器原生格式（YUYV / 8 位 Bayer）的内存布局与 Image 相同，直接拷贝即可
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT>
+        inline void raw_to_image(const uint8_t *src, Image<PF, WIDTH, HEIGHT> &dst)
+        {
+            static_assert(PF == PixelFormat::YUV422 || PF == PixelFormat::BayerRGGB || PF == PixelFormat::BayerBGGR,
+                          "raw_to_image only supports sensor native formats");
+            std::memcpy(dst.get_data_ptr(), src, dst.get_data_size());
+        }
+
+        // 取 Y 通道作为灰度，不做任何运算
+        template <size_t WIDTH, size_t HEIGHT, typename Derived>
+        inline void yuv422_to_gray(const Image<PixelFormat::YUV422, WIDTH, HEIGHT> &src,
+                                   ImageBase<PixelFormat::Grayscale, WIDTH, HEIGHT, Derived> &dst)
+        {
+            for (size_t y = 0; y < HEIGHT; ++y)
+            {
+                for (size_t x = 0; x < WIDTH; ++x)
+                {
+                    dst(x, y).value = src(x, y).y;
+                }
+            }
+        }
+
+        // 每两个像素共享一组 U/V，转换到 RGB 后再 pixel_cast 到目标格式
+        template <size_t WIDTH, size_t HEIGHT, PixelFormat DPF, typename Derived>
+        inline void yuv422_cast(const Image<PixelFormat::YUV422, WIDTH, HEIGHT> &src,
+                                ImageBase<DPF, WIDTH, HEIGHT, Derived> &dst)
+        {
+            static_assert(WIDTH % 2 == 0, "YUV422 width must be even");
+            using DstT = typename PixelFormatTrait<DPF>::type;
+            for (size_t y = 0; y < HEIGHT; ++y)
+            {
+                for (size_t x = 0; x < WIDTH; x += 2)
+                {
+                    const YUV422Pixel &p0 = src(x, y);
+                    const YUV422Pixel &p1 = src(x + 1, y);
+                    DstT out;
+                    pixel_cast(yuv_to_rgb(p0.y, p0.c, p1.c), out);
+                    dst(x, y) = out;
+                    pixel_cast(yuv_to_rgb(p1.y, p0.c, p1.c), out);
+                    dst(x + 1, y) = out;
+                }
+            }
+        }
+
+        template <PixelFormat PF>
+        struct BayerLayout;
+
+        // 2x2 单元内 R 和 B 的位置（G 在另外两个位置）
+        template <>
+        struct BayerLayout<PixelFormat::BayerRGGB>
+        {
+            static constexpr size_t r_dx = 0, r_dy = 0;
+            static constexpr size_t b_dx = 1, b_dy = 1;
+        };
+
+        template <>
+        struct BayerLayout<PixelFormat::BayerBGGR>
+        {
+            static constexpr size_t r_dx = 1, r_dy = 1;
+            static constexpr size_t b_dx = 0, b_dy = 0;
+        };
+
+        // 半分辨率去马赛克：每个 2x2 单元直接得到一个像素（两个 G 取平均），
+        // 不插值，也不需要先转成 RGB565
+        template <PixelFormat BPF, size_t WIDTH, size_t HEIGHT, PixelFormat DPF, typename Derived>
+        inline void debayer_half(const Image<BPF, WIDTH, HEIGHT> &src,
+                                 ImageBase<DPF, WIDTH / 2, HEIGHT / 2, Derived> &dst)
+        {
+            static_assert(WIDTH % 2 == 0 && HEIGHT % 2 == 0, "Bayer image size must be even");
+            using L = BayerLayout<BPF>;
+            using DstT = typename PixelFormatTrait<DPF>::type;
+            constexpr size_t g0_dx = 1 - L::r_dx, g0_dy = L::r_dy;
+            constexpr size_t g1_dx = L::r_dx, g1_dy = 1 - L::r_dy;
+
+            for (size_t y = 0; y < HEIGHT / 2; ++y)
+            {
+                for (size_t x = 0; x < WIDTH / 2; ++x)
+                {
+                    size_t sx = x * 2, sy = y * 2;
+                    RGBPixel rgb{src(sx + L::r_dx, sy + L::r_dy).value,
+                                 static_cast<uint8_t>((src(sx + g0_dx, sy + g0_dy).value +
+                                                       src(sx + g1_dx, sy + g1_dy).value + 1) >> 1),
+                                 src(sx + L::b_dx, sy + L::b_dy).value};
+                    DstT out;
+                    pixel_cast(rgb, out);
+                    dst(x, y) = out;
+                }
+            }
+        }
+
+    }
+}
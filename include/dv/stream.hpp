@@ -0,0 +1,420 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+#include "dv/image.hpp"
+#include "dv/binaryzation.hpp"
+
+namespace dv
+{
+    namespace stream
+    {
+        using namespace image;
+        using namespace pixel_format;
+
+        // 逐行流式处理：相机 DMA 每送来一行就处理一行，只保留少量行缓冲，
+        // 不需要整帧的 Image 和中间结果。二值行使用打包位，bit i 对应第 i 个像素（低位在前），
+        // 每行占 row_bytes<WIDTH>() 个字节，与 Image<Binary> 不同的是每行都从字节边界开始。
+
+        template <size_t WIDTH>
+        constexpr size_t row_bytes()
+        {
+            return (WIDTH + 7) / 8;
+        }
+
+        // 大端 RGB565 原始行 -> RGB565Pixel，与 image::raw_to_rgb565 一致
+        template <size_t WIDTH>
+        inline void raw_to_rgb565_row(const uint8_t *src, RGB565Pixel *dst)
+        {
+            for (size_t x = 0; x < WIDTH; ++x)
+            {
+                uint16_t v = static_cast<uint16_t>(src[2 * x] << 8 | src[2 * x + 1]);
+                std::memcpy(&dst[x], &v, sizeof(v));
+            }
+        }
+
+        template <size_t WIDTH, typename SrcT, typename DstT>
+        inline void row_cast(const SrcT *src, DstT *dst)
+        {
+            for (size_t x = 0; x < WIDTH; ++x)
+            {
+                pixel_cast(src[x], dst[x]);
+            }
+        }
+
+        // 与 binaryzation::threshold 相同的判定，结果写成打包位
+        template <size_t WIDTH, typename TPFT, typename SrcT>
+        inline void threshold_row(const SrcT *src, uint8_t *bits, TPFT t_low, TPFT t_high)
+        {
+            uint8_t acc = 0;
+            for (size_t x = 0; x < WIDTH; ++x)
+            {
+                TPFT pixel;
+                pixel_cast(src[x], pixel);
+                acc |= static_cast<uint8_t>(in_range(pixel, t_low, t_high) << (x % 8));
+                if (x % 8 == 7)
+                {
+                    bits[x / 8] = acc;
+                    acc = 0;
+                }
+            }
+            if (WIDTH % 8)
+                bits[WIDTH / 8] = acc;
+        }
+
+        // 把一行打包位写回整帧二值图（需要整帧结果时使用）
+        template <size_t WIDTH, size_t HEIGHT, typename Derived>
+        inline void store_row(ImageBase<PixelFormat::Binary, WIDTH, HEIGHT, Derived> &dst, size_t y, const uint8_t *bits)
+        {
+            for (size_t x = 0; x < WIDTH; ++x)
+            {
+                dst(x, y) = ((bits[x / 8] >> (x % 8)) & 1) ? BinaryPixel{255} : BinaryPixel{0};
+            }
+        }
+
+        // 最近 ROWS 行的环形缓冲，用于邻域运算
+        template <typename PixelT, size_t WIDTH, size_t ROWS>
+        class LineBuffer
+        {
+        public:
+            void reset()
+            {
+                count_ = 0;
+                head_ = 0;
+            }
+
+            // 返回下一行的写入位置（最旧的一行），可以直接作为 DMA 目标，写完后调用 commit()
+            PixelT *next()
+            {
+                return rows_[head_];
+            }
+
+            void commit()
+            {
+                head_ = (head_ + 1) % ROWS;
+                if (count_ < ROWS)
+                    count_++;
+            }
+
+            void push_row(const PixelT *row)
+            {
+                std::memcpy(next(), row, sizeof(PixelT) * WIDTH);
+                commit();
+            }
+
+            // k = 0 为最新的一行，k = ROWS - 1 为最旧的一行
+            const PixelT *row(size_t k) const
+            {
+                return rows_[(head_ + ROWS - 1 - k) % ROWS];
+            }
+
+            size_t count() const { return count_; }
+            bool full() const { return count_ == ROWS; }
+
+        private:
+            PixelT rows_[ROWS][WIDTH];
+            size_t head_ = 0;
+            size_t count_ = 0;
+        };
+
+        // 逐行累积灰度直方图，帧结束后给出 Otsu 阈值。
+        // 流式模式下当前帧无法回头二值化，通常把本帧的阈值用于下一帧。
+        template <size_t WIDTH>
+        class RowHistogram
+        {
+        public:
+            void reset()
+            {
+                std::memset(hist_, 0, sizeof(hist_));
+                total_ = 0;
+            }
+
+            void push_row(const GrayscalePixel *row)
+            {
+                for (size_t x = 0; x < WIDTH; ++x)
+                {
+                    hist_[row[x].value]++;
+                }
+                total_ += WIDTH;
+            }
+
+            const size_t *histogram() const { return hist_; }
+            size_t total() const { return total_; }
+
+            uint8_t otsu() const
+            {
+                return binaryzation::otsu_threshold(hist_, total_);
+            }
+
+        private:
+            size_t hist_[binaryzation::OTSU_HIST_SIZE] = {0};
+            size_t total_ = 0;
+        };
+
+        // 最近邻缩放（采样位置与 interpolation::nearest_neighbor 相同）：
+        // 每送入一行源图像，就输出所有采样自这一行的目标行
+        template <typename PixelT, size_t SRC_WIDTH, size_t SRC_HEIGHT, size_t DST_WIDTH, size_t DST_HEIGHT>
+        class RowDownscale
+        {
+        public:
+            // emit(dst_y, const PixelT *dst_row)
+            template <typename Fn>
+            void push_row(size_t y, const PixelT *row, Fn &&emit)
+            {
+                // 第一个满足 dy * SRC_HEIGHT / DST_HEIGHT >= y 的目标行
+                size_t dy = (y * DST_HEIGHT + SRC_HEIGHT - 1) / SRC_HEIGHT;
+                bool sampled = false;
+                for (; dy < DST_HEIGHT && dy * SRC_HEIGHT / DST_HEIGHT == y; ++dy)
+                {
+                    if (!sampled)
+                    {
+                        for (size_t x = 0; x < DST_WIDTH; ++x)
+                            out_[x] = row[x * SRC_WIDTH / DST_WIDTH];
+                        sampled = true;
+                    }
+                    emit(dy, static_cast<const PixelT *>(out_));
+                }
+            }
+
+        private:
+            PixelT out_[DST_WIDTH];
+        };
+
+        struct Blob
+        {
+            uint32_t area;
+            uint16_t x0; // 包围盒 [x0, x1] x [y0, y1]
+            uint16_t y0;
+            uint16_t x1;
+            uint16_t y1;
+            uint64_t sum_x;
+            uint64_t sum_y;
+
+            static constexpr int CENTROID_FRAC_BITS = 8;
+
+            float cx() const { return area ? static_cast<float>(sum_x) / area : 0.0f; }
+            float cy() const { return area ? static_cast<float>(sum_y) / area : 0.0f; }
+
+            // 定点质心（24.8，四舍五入），整数构建使用
+            uint32_t cx_fixed() const { return centroid_fixed_(sum_x); }
+            uint32_t cy_fixed() const { return centroid_fixed_(sum_y); }
+
+        private:
+            uint32_t centroid_fixed_(uint64_t sum) const
+            {
+                return area ? static_cast<uint32_t>(((sum << CENTROID_FRAC_BITS) + area / 2) / area) : 0;
+            }
+        };
+
+        // 逐行提取游程并做 8 连通的连通域合并，只保留上一行的游程。
+        // 最后一行送入后调用 finish()，结果立即可用。
+        template <size_t WIDTH, size_t MAX_LABELS = 256, size_t MAX_RUNS_PER_ROW = WIDTH / 2 + 1>
+        class RunExtractor
+        {
+        public:
+            void reset()
+            {
+                label_count_ = 0;
+                prev_count_ = 0;
+                blob_count_ = 0;
+                dropped_ = 0;
+            }
+
+            void push_row(size_t y, const uint8_t *bits)
+            {
+                push_row(y, bits, nullptr);
+            }
+
+            // tiles: 该行所在块行的占用位图（binaryzation::OccupancyMap::tile_row），
+            // 不在游程中时跳过 64 个像素内全空的字
+            void push_row(size_t y, const uint8_t *bits, const uint64_t *tiles)
+            {
+                size_t cur_count = 0;
+                size_t p = 0; // 上一行中第一个可能相连的游程
+
+                constexpr size_t BYTES = row_bytes<WIDTH>();
+                bool ones = false;
+                size_t run_start = 0;
+                for (size_t base = 0; base < WIDTH; base += 64)
+                {
+                    if (tiles && !ones && !((tiles[base / 512] >> (base / 8 % 64)) & 0xFF))
+                        continue;
+                    uint64_t w = 0;
+                    size_t off = base / 8;
+                    std::memcpy(&w, bits + off, BYTES - off < 8 ? BYTES - off : 8);
+                    size_t valid = WIDTH - base < 64 ? WIDTH - base : 64;
+                    uint64_t valid_mask = valid < 64 ? (uint64_t(1) << valid) - 1 : ~uint64_t(0);
+                    w &= valid_mask;
+
+                    uint64_t diff = (ones ? ~w : w) & valid_mask;
+                    while (diff)
+                    {
+                        unsigned t = static_cast<unsigned>(__builtin_ctzll(diff));
+                        size_t pos = base + t;
+                        if (ones)
+                            add_run(y, run_start, pos, cur_count, p);
+                        else
+                            run_start = pos;
+                        ones = !ones;
+                        diff = (ones ? ~w : w) & valid_mask & (~uint64_t(0) << t);
+                    }
+                }
+                if (ones)
+                    add_run(y, run_start, WIDTH, cur_count, p);
+
+                std::memcpy(prev_, cur_, sizeof(Run) * cur_count);
+                prev_count_ = cur_count;
+            }
+
+            // 整帧二值图：空的块行只清空上一行的游程，非空块行只扫描有像素的字
+            template <size_t HEIGHT, typename Derived>
+            void extract(const ImageBase<PixelFormat::Binary, WIDTH, HEIGHT, Derived> &img,
+                         const binaryzation::OccupancyMap<WIDTH, HEIGHT> &occupancy)
+            {
+                reset();
+                uint8_t scratch[row_bytes<WIDTH>()];
+                for (size_t ty = 0; ty < occupancy.TILES_Y; ++ty)
+                {
+                    if (!occupancy.row_occupied(ty))
+                    {
+                        prev_count_ = 0;
+                        continue;
+                    }
+                    const size_t y_end = ty * 8 + 8 < HEIGHT ? ty * 8 + 8 : HEIGHT;
+                    for (size_t y = ty * 8; y < y_end; ++y)
+                    {
+                        push_row(y, binaryzation::row_bits(img, y, scratch), occupancy.tile_row(ty));
+                    }
+                }
+                finish();
+            }
+
+            void finish()
+            {
+                // 把每个标签的统计合并到根标签上
+                for (size_t i = 0; i < label_count_; ++i)
+                {
+                    size_t r = find(i);
+                    if (r != i)
+                    {
+                        merge_stats(stats_[r], stats_[i]);
+                        stats_[i].area = 0;
+                    }
+                }
+                blob_count_ = 0;
+                for (size_t i = 0; i < label_count_; ++i)
+                {
+                    if (stats_[i].area)
+                        blobs_[blob_count_++] = stats_[i];
+                }
+                prev_count_ = 0;
+            }
+
+            size_t blob_count() const { return blob_count_; }
+            const Blob &blob(size_t i) const { return blobs_[i]; }
+            // 标签或单行游程数量用尽而被丢弃的游程数
+            size_t dropped() const { return dropped_; }
+
+        private:
+            struct Run
+            {
+                uint16_t x0; // [x0, x1)
+                uint16_t x1;
+                uint16_t label;
+            };
+
+            void add_run(size_t y, size_t x0, size_t x1, size_t &cur_count, size_t &p)
+            {
+                if (cur_count >= MAX_RUNS_PER_ROW)
+                {
+                    dropped_++;
+                    return;
+                }
+
+                // 上一行游程按 x 有序，跳过完全在左侧的（8 连通：prev.x1 < x0 不相连）
+                while (p < prev_count_ && prev_[p].x1 < x0)
+                    p++;
+
+                size_t label = MAX_LABELS;
+                for (size_t q = p; q < prev_count_ && prev_[q].x0 <= x1; ++q)
+                {
+                    size_t l = find(prev_[q].label);
+                    if (label == MAX_LABELS)
+                        label = l;
+                    else if (l != label)
+                    {
+                        // 合并到较小的标签
+                        if (l < label)
+                            std::swap(l, label);
+                        parent_[l] = static_cast<uint16_t>(label);
+                    }
+                }
+                // 下一个游程也可能与 prev_[q-1] 相连，所以 p 不越过它
+                if (label == MAX_LABELS)
+                {
+                    if (label_count_ >= MAX_LABELS)
+                    {
+                        dropped_++;
+                        return;
+                    }
+                    label = label_count_++;
+                    parent_[label] = static_cast<uint16_t>(label);
+                    stats_[label] = Blob{0, static_cast<uint16_t>(x0), static_cast<uint16_t>(y),
+                                         static_cast<uint16_t>(x1 - 1), static_cast<uint16_t>(y), 0, 0};
+                }
+
+                Blob run_stats{static_cast<uint32_t>(x1 - x0),
+                               static_cast<uint16_t>(x0), static_cast<uint16_t>(y),
+                               static_cast<uint16_t>(x1 - 1), static_cast<uint16_t>(y),
+                               static_cast<uint64_t>(x0 + x1 - 1) * (x1 - x0) / 2,
+                               static_cast<uint64_t>(y) * (x1 - x0)};
+                merge_stats(stats_[label], run_stats);
+                cur_[cur_count++] = Run{static_cast<uint16_t>(x0), static_cast<uint16_t>(x1), static_cast<uint16_t>(label)};
+            }
+
+            size_t find(size_t l)
+            {
+                while (parent_[l] != l)
+                {
+                    parent_[l] = parent_[parent_[l]];
+                    l = parent_[l];
+                }
+                return l;
+            }
+
+            static void merge_stats(Blob &dst, const Blob &src)
+            {
+                if (src.area == 0)
+                    return;
+                if (dst.area == 0)
+                {
+                    dst = src;
+                    return;
+                }
+                dst.area += src.area;
+                dst.x0 = std::min(dst.x0, src.x0);
+                dst.y0 = std::min(dst.y0, src.y0);
+                dst.x1 = std::max(dst.x1, src.x1);
+                dst.y1 = std::max(dst.y1, src.y1);
+                dst.sum_x += src.sum_x;
+                dst.sum_y += src.sum_y;
+            }
+
+            Run prev_[MAX_RUNS_PER_ROW];
+            Run cur_[MAX_RUNS_PER_ROW];
+            size_t prev_count_ = 0;
+
+            uint16_t parent_[MAX_LABELS];
+            Blob stats_[MAX_LABELS];
+            size_t label_count_ = 0;
+
+            Blob blobs_[MAX_LABELS];
+            size_t blob_count_ = 0;
+            size_t dropped_ = 0;
+        };
+
+    }
+}
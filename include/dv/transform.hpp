@@ -0,0 +1,535 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "dv/image.hpp"
+
+namespace dv
+{
+    namespace transform
+    {
+        using namespace image;
+        using namespace pixel_format;
+
+        // 旋转/翻转/转置。逐像素 dst(y, x) = src(x, y) 写列时每个像素都落在不同的缓存行上，
+        // 这里按 BLOCK x BLOCK 的块遍历，块内再按 8x8 小块转置（8/16 位像素有 SIMD 版本），
+        // 读写都只在少量缓存行内进行。
+        // 旋转 90° 和 270° 只是转置时源行或目标行倒序，全部复用同一个转置核。
+        // 二值图按位打包，宽高都是 8 的倍数时以 8x8 位块（一个 uint64_t）转置，否则逐像素处理。
+
+        static constexpr size_t BLOCK = 32;
+
+        template <size_t N>
+        struct Bytes_
+        {
+            uint8_t b[N];
+        };
+
+        // 按像素大小选择搬运用的类型
+        template <size_t N>
+        struct Word_
+        {
+            using type = Bytes_<N>;
+        };
+
+        template <>
+        struct Word_<1>
+        {
+            using type = uint8_t;
+        };
+
+        template <>
+        struct Word_<2>
+        {
+            using type = uint16_t;
+        };
+
+        template <>
+        struct Word_<4>
+        {
+            using type = uint32_t;
+        };
+
+        // 8x8 小块：dst[c * dst_stride + r] = src[r * src_stride + c]，步长可以为负
+        template <typename T>
+        inline void transpose8x8_(const T *src, ptrdiff_t src_stride, T *dst, ptrdiff_t dst_stride)
+        {
+            for (ptrdiff_t r = 0; r < 8; ++r)
+            {
+                for (ptrdiff_t c = 0; c < 8; ++c)
+                {
+                    dst[c * dst_stride + r] = src[r * src_stride + c];
+                }
+            }
+        }
+
+        template <>
+        inline void transpose8x8_<uint8_t>(const uint8_t *src, ptrdiff_t src_stride, uint8_t *dst, ptrdiff_t dst_stride)
+        {
+#if defined(__AVX2__) || defined(__SSE2__)
+            __m128i r[8];
+            for (int i = 0; i < 8; ++i)
+                r[i] = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i * src_stride));
+            __m128i a0 = _mm_unpacklo_epi8(r[0], r[1]);
+            __m128i a1 = _mm_unpacklo_epi8(r[2], r[3]);
+            __m128i a2 = _mm_unpacklo_epi8(r[4], r[5]);
+            __m128i a3 = _mm_unpacklo_epi8(r[6], r[7]);
+            __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+            __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+            __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+            __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+            // 每个寄存器的低、高 8 字节各是一列
+            __m128i c[4] = {_mm_unpacklo_epi32(b0, b2), _mm_unpackhi_epi32(b0, b2),
+                            _mm_unpacklo_epi32(b1, b3), _mm_unpackhi_epi32(b1, b3)};
+            for (int i = 0; i < 4; ++i)
+            {
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + (2 * i) * dst_stride), c[i]);
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + (2 * i + 1) * dst_stride), _mm_unpackhi_epi64(c[i], c[i]));
+            }
+#elif defined(__ARM_NEON)
+            uint8x8x2_t t01 = vtrn_u8(vld1_u8(src), vld1_u8(src + src_stride));
+            uint8x8x2_t t23 = vtrn_u8(vld1_u8(src + 2 * src_stride), vld1_u8(src + 3 * src_stride));
+            uint8x8x2_t t45 = vtrn_u8(vld1_u8(src + 4 * src_stride), vld1_u8(src + 5 * src_stride));
+            uint8x8x2_t t67 = vtrn_u8(vld1_u8(src + 6 * src_stride), vld1_u8(src + 7 * src_stride));
+            uint16x4x2_t u02 = vtrn_u16(vreinterpret_u16_u8(t01.val[0]), vreinterpret_u16_u8(t23.val[0]));
+            uint16x4x2_t u13 = vtrn_u16(vreinterpret_u16_u8(t01.val[1]), vreinterpret_u16_u8(t23.val[1]));
+            uint16x4x2_t u46 = vtrn_u16(vreinterpret_u16_u8(t45.val[0]), vreinterpret_u16_u8(t67.val[0]));
+            uint16x4x2_t u57 = vtrn_u16(vreinterpret_u16_u8(t45.val[1]), vreinterpret_u16_u8(t67.val[1]));
+            // 第 i 个结果的 val[0]、val[1] 分别是第 i、i + 4 列
+            uint32x2x2_t v[4] = {vtrn_u32(vreinterpret_u32_u16(u02.val[0]), vreinterpret_u32_u16(u46.val[0])),
+                                 vtrn_u32(vreinterpret_u32_u16(u13.val[0]), vreinterpret_u32_u16(u57.val[0])),
+                                 vtrn_u32(vreinterpret_u32_u16(u02.val[1]), vreinterpret_u32_u16(u46.val[1])),
+                                 vtrn_u32(vreinterpret_u32_u16(u13.val[1]), vreinterpret_u32_u16(u57.val[1]))};
+            for (int i = 0; i < 4; ++i)
+            {
+                vst1_u8(dst + i * dst_stride, vreinterpret_u8_u32(v[i].val[0]));
+                vst1_u8(dst + (i + 4) * dst_stride, vreinterpret_u8_u32(v[i].val[1]));
+            }
+#else
+            for (ptrdiff_t r = 0; r < 8; ++r)
+            {
+                for (ptrdiff_t c = 0; c < 8; ++c)
+                {
+                    dst[c * dst_stride + r] = src[r * src_stride + c];
+                }
+            }
+#endif
+        }
+
+        template <>
+        inline void transpose8x8_<uint16_t>(const uint16_t *src, ptrdiff_t src_stride, uint16_t *dst, ptrdiff_t dst_stride)
+        {
+#if defined(__AVX2__) || defined(__SSE2__)
+            __m128i r[8];
+            for (int i = 0; i < 8; ++i)
+                r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * src_stride));
+            __m128i a0 = _mm_unpacklo_epi16(r[0], r[1]);
+            __m128i a1 = _mm_unpackhi_epi16(r[0], r[1]);
+            __m128i a2 = _mm_unpacklo_epi16(r[2], r[3]);
+            __m128i a3 = _mm_unpackhi_epi16(r[2], r[3]);
+            __m128i a4 = _mm_unpacklo_epi16(r[4], r[5]);
+            __m128i a5 = _mm_unpackhi_epi16(r[4], r[5]);
+            __m128i a6 = _mm_unpacklo_epi16(r[6], r[7]);
+            __m128i a7 = _mm_unpackhi_epi16(r[6], r[7]);
+            // 行 0~3 / 行 4~7 的第 2i、2i + 1 列
+            __m128i lo[4] = {_mm_unpacklo_epi32(a0, a2), _mm_unpackhi_epi32(a0, a2),
+                             _mm_unpacklo_epi32(a1, a3), _mm_unpackhi_epi32(a1, a3)};
+            __m128i hi[4] = {_mm_unpacklo_epi32(a4, a6), _mm_unpackhi_epi32(a4, a6),
+                             _mm_unpacklo_epi32(a5, a7), _mm_unpackhi_epi32(a5, a7)};
+            for (int i = 0; i < 4; ++i)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + (2 * i) * dst_stride), _mm_unpacklo_epi64(lo[i], hi[i]));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + (2 * i + 1) * dst_stride), _mm_unpackhi_epi64(lo[i], hi[i]));
+            }
+#elif defined(__ARM_NEON)
+            uint16x8x2_t t01 = vtrnq_u16(vld1q_u16(src), vld1q_u16(src + src_stride));
+            uint16x8x2_t t23 = vtrnq_u16(vld1q_u16(src + 2 * src_stride), vld1q_u16(src + 3 * src_stride));
+            uint16x8x2_t t45 = vtrnq_u16(vld1q_u16(src + 4 * src_stride), vld1q_u16(src + 5 * src_stride));
+            uint16x8x2_t t67 = vtrnq_u16(vld1q_u16(src + 6 * src_stride), vld1q_u16(src + 7 * src_stride));
+            // lo[i]/hi[i]：行 0~3 / 行 4~7，val[0] 的两半是第 i、i + 4 列，val[1] 的两半是第 i + 2、i + 6 列
+            uint32x4x2_t lo[2] = {vtrnq_u32(vreinterpretq_u32_u16(t01.val[0]), vreinterpretq_u32_u16(t23.val[0])),
+                                  vtrnq_u32(vreinterpretq_u32_u16(t01.val[1]), vreinterpretq_u32_u16(t23.val[1]))};
+            uint32x4x2_t hi[2] = {vtrnq_u32(vreinterpretq_u32_u16(t45.val[0]), vreinterpretq_u32_u16(t67.val[0])),
+                                  vtrnq_u32(vreinterpretq_u32_u16(t45.val[1]), vreinterpretq_u32_u16(t67.val[1]))};
+            for (int i = 0; i < 2; ++i)
+            {
+                for (int j = 0; j < 2; ++j)
+                {
+                    uint16x8_t a = vreinterpretq_u16_u32(lo[i].val[j]);
+                    uint16x8_t b = vreinterpretq_u16_u32(hi[i].val[j]);
+                    vst1q_u16(dst + (i + 2 * j) * dst_stride, vcombine_u16(vget_low_u16(a), vget_low_u16(b)));
+                    vst1q_u16(dst + (i + 2 * j + 4) * dst_stride, vcombine_u16(vget_high_u16(a), vget_high_u16(b)));
+                }
+            }
+#else
+            for (ptrdiff_t r = 0; r < 8; ++r)
+            {
+                for (ptrdiff_t c = 0; c < 8; ++c)
+                {
+                    dst[c * dst_stride + r] = src[r * src_stride + c];
+                }
+            }
+#endif
+        }
+
+        // rows x cols 的矩阵转置到 dst，src/dst 指向逻辑上的第 0 行，步长为负时即行倒序
+        template <typename T>
+        inline void transpose_(const T *src, ptrdiff_t src_stride, T *dst, ptrdiff_t dst_stride, size_t rows, size_t cols)
+        {
+            for (size_t by = 0; by < rows; by += BLOCK)
+            {
+                const size_t ey = by + BLOCK < rows ? by + BLOCK : rows;
+                for (size_t bx = 0; bx < cols; bx += BLOCK)
+                {
+                    const size_t ex = bx + BLOCK < cols ? bx + BLOCK : cols;
+                    size_t y = by;
+                    for (; y + 8 <= ey; y += 8)
+                    {
+                        size_t x = bx;
+                        for (; x + 8 <= ex; x += 8)
+                        {
+                            transpose8x8_<T>(src + ptrdiff_t(y) * src_stride + ptrdiff_t(x), src_stride,
+                                             dst + ptrdiff_t(x) * dst_stride + ptrdiff_t(y), dst_stride);
+                        }
+                        for (size_t r = y; r < y + 8; ++r)
+                        {
+                            for (size_t c = x; c < ex; ++c)
+                            {
+                                dst[ptrdiff_t(c) * dst_stride + ptrdiff_t(r)] = src[ptrdiff_t(r) * src_stride + ptrdiff_t(c)];
+                            }
+                        }
+                    }
+                    for (; y < ey; ++y)
+                    {
+                        for (size_t c = bx; c < ex; ++c)
+                        {
+                            dst[ptrdiff_t(c) * dst_stride + ptrdiff_t(y)] = src[ptrdiff_t(y) * src_stride + ptrdiff_t(c)];
+                        }
+                    }
+                }
+            }
+        }
+
+        // 一行倒序
+        template <typename T>
+        inline void reverse_row_(const T *src, T *dst, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                dst[n - 1 - i] = src[i];
+            }
+        }
+
+        template <>
+        inline void reverse_row_<uint16_t>(const uint16_t *src, uint16_t *dst, size_t n)
+        {
+            size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+            for (; i + 8 <= n; i += 8)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                v = _mm_shufflelo_epi16(v, 0x1B);
+                v = _mm_shufflehi_epi16(v, 0x1B);
+                v = _mm_shuffle_epi32(v, 0x4E);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + n - 8 - i), v);
+            }
+#elif defined(__ARM_NEON)
+            for (; i + 8 <= n; i += 8)
+            {
+                uint16x8_t v = vrev64q_u16(vld1q_u16(src + i));
+                vst1q_u16(dst + n - 8 - i, vcombine_u16(vget_high_u16(v), vget_low_u16(v)));
+            }
+#endif
+            // 尾部从两端用指针走：写成 dst[n - 1 - i] 时，n 为编译期常量、尾部已走不到的情况下
+            // GCC 会误报 -Waggressive-loop-optimizations
+            const uint16_t *s = src + i;
+            for (uint16_t *d = dst + (n - i); d != dst;)
+            {
+                *--d = *s++;
+            }
+        }
+
+        template <>
+        inline void reverse_row_<uint8_t>(const uint8_t *src, uint8_t *dst, size_t n)
+        {
+            size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+            for (; i + 16 <= n; i += 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+                v = _mm_shufflelo_epi16(v, 0x1B);
+                v = _mm_shufflehi_epi16(v, 0x1B);
+                v = _mm_shuffle_epi32(v, 0x4E);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + n - 16 - i), v);
+            }
+#elif defined(__ARM_NEON)
+            for (; i + 16 <= n; i += 16)
+            {
+                uint8x16_t v = vrev64q_u8(vld1q_u8(src + i));
+                vst1q_u8(dst + n - 16 - i, vcombine_u8(vget_high_u8(v), vget_low_u8(v)));
+            }
+#endif
+            // 尾部写法同 uint16_t 版本
+            const uint8_t *s = src + i;
+            for (uint8_t *d = dst + (n - i); d != dst;)
+            {
+                *--d = *s++;
+            }
+        }
+
+        inline uint8_t reverse_bits_(uint8_t b)
+        {
+            b = static_cast<uint8_t>((b & 0xF0) >> 4 | (b & 0x0F) << 4);
+            b = static_cast<uint8_t>((b & 0xCC) >> 2 | (b & 0x33) << 2);
+            return static_cast<uint8_t>((b & 0xAA) >> 1 | (b & 0x55) << 1);
+        }
+
+        // 8x8 位矩阵转置，第 r 字节的第 c 位（LSB 起）与第 c 字节的第 r 位交换
+        inline uint64_t transpose_bits8x8_(uint64_t x)
+        {
+            uint64_t t;
+            t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull;
+            x ^= t ^ (t << 7);
+            t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull;
+            x ^= t ^ (t << 14);
+            t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull;
+            x ^= t ^ (t << 28);
+            return x;
+        }
+
+        // 打包二值图的转置，rows、cols 都是 8 的倍数，步长以字节计
+        inline void transpose_bits_(const uint8_t *src, ptrdiff_t src_stride, uint8_t *dst, ptrdiff_t dst_stride,
+                                    size_t rows, size_t cols)
+        {
+            for (size_t by = 0; by < rows; by += 8)
+            {
+                const uint8_t *in = src + ptrdiff_t(by) * src_stride;
+                for (size_t bx = 0; bx < cols / 8; ++bx)
+                {
+                    uint64_t x = 0;
+                    for (int r = 0; r < 8; ++r)
+                        x |= uint64_t(in[r * src_stride + ptrdiff_t(bx)]) << (8 * r);
+                    x = transpose_bits8x8_(x);
+                    uint8_t *out = dst + ptrdiff_t(bx * 8) * dst_stride + ptrdiff_t(by / 8);
+                    for (int c = 0; c < 8; ++c)
+                        out[c * dst_stride] = static_cast<uint8_t>(x >> (8 * c));
+                }
+            }
+        }
+
+        // 逐像素的通用版本，二值图宽高不是 8 的倍数时使用；map(x, y, dx, dy) 给出目标坐标
+        template <typename Src, typename Dst, typename Map>
+        inline void remap_pixels_(const Src &src, Dst &dst, Map map)
+        {
+            for (size_t by = 0; by < Src::image_height; by += BLOCK)
+            {
+                for (size_t bx = 0; bx < Src::image_width; bx += BLOCK)
+                {
+                    for (size_t y = by; y < by + BLOCK && y < Src::image_height; ++y)
+                    {
+                        for (size_t x = bx; x < bx + BLOCK && x < Src::image_width; ++x)
+                        {
+                            size_t dx, dy;
+                            map(x, y, dx, dy);
+                            dst(dx, dy) = src(x, y);
+                        }
+                    }
+                }
+            }
+        }
+
+        // 三种转置类操作共用：rows 为 HEIGHT，源逻辑行 r 对应 src_row0 + r * src_step 行，
+        // 目标逻辑行 c 对应 dst_row0 + c * dst_step 行
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT, typename Src, typename Dst>
+        inline void transpose_image_(const ImageBase<PF, WIDTH, HEIGHT, Src> &src, ImageBase<PF, HEIGHT, WIDTH, Dst> &dst,
+                                     bool flip_src_rows, bool flip_dst_rows)
+        {
+            const Src &s = static_cast<const Src &>(src);
+            Dst &d = static_cast<Dst &>(dst);
+            if constexpr (PF == PixelFormat::Binary)
+            {
+                if constexpr (WIDTH % 8 == 0 && HEIGHT % 8 == 0)
+                {
+                    const ptrdiff_t src_stride = WIDTH / 8, dst_stride = HEIGHT / 8;
+                    const uint8_t *in = static_cast<const uint8_t *>(s.get_data_ptr());
+                    uint8_t *out = static_cast<uint8_t *>(d.get_data_ptr());
+                    transpose_bits_(flip_src_rows ? in + (HEIGHT - 1) * src_stride : in, flip_src_rows ? -src_stride : src_stride,
+                                    flip_dst_rows ? out + (WIDTH - 1) * dst_stride : out, flip_dst_rows ? -dst_stride : dst_stride,
+                                    HEIGHT, WIDTH);
+                }
+                else
+                {
+                    remap_pixels_(s, d, [&](size_t x, size_t y, size_t &dx, size_t &dy)
+                                  {
+                                      dx = flip_src_rows ? HEIGHT - 1 - y : y;
+                                      dy = flip_dst_rows ? WIDTH - 1 - x : x;
+                                  });
+                }
+            }
+            else
+            {
+                using T = typename Word_<sizeof(typename PixelFormatTrait<PF>::type)>::type;
+                const ptrdiff_t src_stride = WIDTH, dst_stride = HEIGHT;
+                const T *in = static_cast<const T *>(s.get_data_ptr());
+                T *out = static_cast<T *>(d.get_data_ptr());
+                transpose_<T>(flip_src_rows ? in + (HEIGHT - 1) * src_stride : in, flip_src_rows ? -src_stride : src_stride,
+                              flip_dst_rows ? out + (WIDTH - 1) * dst_stride : out, flip_dst_rows ? -dst_stride : dst_stride,
+                              HEIGHT, WIDTH);
+            }
+        }
+
+        // dst(y, x) = src(x, y)
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT, typename Src, typename Dst>
+        inline void transpose(const ImageBase<PF, WIDTH, HEIGHT, Src> &src, ImageBase<PF, HEIGHT, WIDTH, Dst> &dst)
+        {
+            transpose_image_(src, dst, false, false);
+        }
+
+        // 顺时针 90°：dst(HEIGHT - 1 - y, x) = src(x, y)
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT, typename Src, typename Dst>
+        inline void rotate90(const ImageBase<PF, WIDTH, HEIGHT, Src> &src, ImageBase<PF, HEIGHT, WIDTH, Dst> &dst)
+        {
+            transpose_image_(src, dst, true, false);
+        }
+
+        // 顺时针 270°（逆时针 90°）：dst(y, WIDTH - 1 - x) = src(x, y)
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT, typename Src, typename Dst>
+        inline void rotate270(const ImageBase<PF, WIDTH, HEIGHT, Src> &src, ImageBase<PF, HEIGHT, WIDTH, Dst> &dst)
+        {
+            transpose_image_(src, dst, false, true);
+        }
+
+        // 行内倒序，reverse_rows 时行也倒序（即旋转 180°）
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT, typename Src, typename Dst>
+        inline void mirror_image_(const ImageBase<PF, WIDTH, HEIGHT, Src> &src, ImageBase<PF, WIDTH, HEIGHT, Dst> &dst,
+                                  bool reverse_rows)
+        {
+            const Src &s = static_cast<const Src &>(src);
+            Dst &d = static_cast<Dst &>(dst);
+            if constexpr (PF == PixelFormat::Binary)
+            {
+                if constexpr (WIDTH % 8 == 0)
+                {
+                    const size_t stride = WIDTH / 8;
+                    const uint8_t *in = static_cast<const uint8_t *>(s.get_data_ptr());
+                    uint8_t *out = static_cast<uint8_t *>(d.get_data_ptr());
+                    for (size_t y = 0; y < HEIGHT; ++y)
+                    {
+                        const uint8_t *row = in + y * stride;
+                        uint8_t *dst_row = out + (reverse_rows ? HEIGHT - 1 - y : y) * stride;
+                        for (size_t i = 0; i < stride; ++i)
+                        {
+                            dst_row[stride - 1 - i] = reverse_bits_(row[i]);
+                        }
+                    }
+                }
+                else
+                {
+                    remap_pixels_(s, d, [&](size_t x, size_t y, size_t &dx, size_t &dy)
+                                  {
+                                      dx = WIDTH - 1 - x;
+                                      dy = reverse_rows ? HEIGHT - 1 - y : y;
+                                  });
+                }
+            }
+            else
+            {
+                using T = typename Word_<sizeof(typename PixelFormatTrait<PF>::type)>::type;
+                const T *in = static_cast<const T *>(s.get_data_ptr());
+                T *out = static_cast<T *>(d.get_data_ptr());
+                for (size_t y = 0; y < HEIGHT; ++y)
+                {
+                    reverse_row_<T>(in + y * WIDTH, out + (reverse_rows ? HEIGHT - 1 - y : y) * WIDTH, WIDTH);
+                }
+            }
+        }
+
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT, typename Src, typename Dst>
+        inline void rotate180(const ImageBase<PF, WIDTH, HEIGHT, Src> &src, ImageBase<PF, WIDTH, HEIGHT, Dst> &dst)
+        {
+            mirror_image_(src, dst, true);
+        }
+
+        // 左右翻转：dst(WIDTH - 1 - x, y) = src(x, y)
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT, typename Src, typename Dst>
+        inline void flip_horizontal(const ImageBase<PF, WIDTH, HEIGHT, Src> &src, ImageBase<PF, WIDTH, HEIGHT, Dst> &dst)
+        {
+            mirror_image_(src, dst, false);
+        }
+
+        // 上下翻转：dst(x, HEIGHT - 1 - y) = src(x, y)
+        template <PixelFormat PF, size_t WIDTH, size_t HEIGHT, typename Src, typename Dst>
+        inline void flip_vertical(const ImageBase<PF, WIDTH, HEIGHT, Src> &src, ImageBase<PF, WIDTH, HEIGHT, Dst> &dst)
+        {
+            const Src &s = static_cast<const Src &>(src);
+            Dst &d = static_cast<Dst &>(dst);
+            if constexpr (PF == PixelFormat::Binary && WIDTH % 8 != 0)
+            {
+                remap_pixels_(s, d, [](size_t x, size_t y, size_t &dx, size_t &dy)
+                              {
+                                  dx = x;
+                                  dy = HEIGHT - 1 - y;
+                              });
+            }
+            else
+            {
+                const size_t row_bytes = PF == PixelFormat::Binary ? WIDTH / 8 : WIDTH * sizeof(typename PixelFormatTrait<PF>::type);
+                const uint8_t *in = static_cast<const uint8_t *>(s.get_data_ptr());
+                uint8_t *out = static_cast<uint8_t *>(d.get_data_ptr());
+                for (size_t y = 0; y < HEIGHT; ++y)
+                {
+                    std::memcpy(out + (HEIGHT - 1 - y) * row_bytes, in + y * row_bytes, row_bytes);
+                }
+            }
+        }
+
+        // 读入原始帧（与 image::raw_to_rgb565 相同的大端格式）时直接旋转，不需要额外一遍。
+        // 每次把 8 行换好字节序放进行缓冲，再用转置核写出。
+        template <size_t WIDTH, size_t HEIGHT, typename Dst>
+        inline void raw_to_rgb565_transposed_(const uint8_t *src, ImageBase<PixelFormat::RGB565, HEIGHT, WIDTH, Dst> &dst,
+                                              bool flip_src_rows, bool flip_dst_rows)
+        {
+            uint16_t strip[8 * WIDTH];
+            uint16_t *out = static_cast<uint16_t *>(static_cast<Dst &>(dst).get_data_ptr());
+            const ptrdiff_t dst_stride = flip_dst_rows ? -ptrdiff_t(HEIGHT) : ptrdiff_t(HEIGHT);
+            uint16_t *out_row0 = flip_dst_rows ? out + (WIDTH - 1) * HEIGHT : out;
+            for (size_t y = 0; y < HEIGHT; y += 8)
+            {
+                const size_t rows = y + 8 <= HEIGHT ? 8 : HEIGHT - y;
+                for (size_t r = 0; r < rows; ++r)
+                {
+                    const size_t sy = flip_src_rows ? HEIGHT - 1 - (y + r) : y + r;
+                    const uint8_t *in = src + sy * WIDTH * 2;
+                    for (size_t x = 0; x < WIDTH; ++x)
+                    {
+                        strip[r * WIDTH + x] = static_cast<uint16_t>(in[2 * x] << 8 | in[2 * x + 1]);
+                    }
+                }
+                transpose_<uint16_t>(strip, WIDTH, out_row0 + y, dst_stride, rows, WIDTH);
+            }
+        }
+
+        // WIDTH x HEIGHT 的原始帧顺时针旋转 90° 后存入 HEIGHT x WIDTH 的图像
+        template <size_t WIDTH, size_t HEIGHT, typename Dst>
+        inline void raw_to_rgb565_rotate90(const uint8_t *src, ImageBase<PixelFormat::RGB565, HEIGHT, WIDTH, Dst> &dst)
+        {
+            raw_to_rgb565_transposed_<WIDTH, HEIGHT>(src, dst, true, false);
+        }
+
+        template <size_t WIDTH, size_t HEIGHT, typename Dst>
+        inline void raw_to_rgb565_rotate270(const uint8_t *src, ImageBase<PixelFormat::RGB565, HEIGHT, WIDTH, Dst> &dst)
+        {
+            raw_to_rgb565_transposed_<WIDTH, HEIGHT>(src, dst, false, true);
+        }
+
+    }
+}
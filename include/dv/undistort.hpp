@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <type_traits>
+
+#include "dv/image.hpp"
+#include "dv/stream.hpp"
+
+namespace dv
+{
+    namespace undistort
+    {
+        using namespace image;
+        using namespace pixel_format;
+
+        // 针孔相机内参 + Brown-Conrady 畸变系数（与 OpenCV 的 k1, k2, p1, p2, k3 含义相同）
+        struct CameraModel
+        {
+            float fx;
+            float fy;
+            float cx;
+            float cy;
+            float k1 = 0;
+            float k2 = 0;
+            float p1 = 0;
+            float p2 = 0;
+            float k3 = 0;
+
+            // 归一化坐标 (x, y) 加上畸变
+            void distort(float x, float y, float &xd, float &yd) const
+            {
+                float r2 = x * x + y * y;
+                float radial = 1 + r2 * (k1 + r2 * (k2 + r2 * k3));
+                xd = x * radial + 2 * p1 * x * y + p2 * (r2 + 2 * x * x);
+                yd = y * radial + p1 * (r2 + 2 * y * y) + 2 * p2 * x * y;
+            }
+
+            // 反向求解：不动点迭代，对常见的畸变量几次就收敛
+            void undistort(float xd, float yd, float &x, float &y, int iterations = 8) const
+            {
+                x = xd;
+                y = yd;
+                for (int i = 0; i < iterations; ++i)
+                {
+                    float r2 = x * x + y * y;
+                    float radial = 1 + r2 * (k1 + r2 * (k2 + r2 * k3));
+                    float dx = 2 * p1 * x * y + p2 * (r2 + 2 * x * x);
+                    float dy = p1 * (r2 + 2 * y * y) + 2 * p2 * x * y;
+                    x = (xd - dx) / radial;
+                    y = (yd - dy) / radial;
+                }
+            }
+        };
+
+        struct Point
+        {
+            float x;
+            float y;
+        };
+
+        // 稀疏模式：只把检测到的点（像素坐标）变换到无畸变的像素坐标，不需要整帧重映射。
+        // 相机模型是浮点的，DV_INTEGER_ONLY 构建中这里是逐帧浮点运算的例外：每帧只处理少量检测点，
+        // 在无 FPU 的目标上走软浮点；整帧的 RemapTable 只在 build() 时用浮点，应用时是纯整数
+        inline Point undistort_point(const CameraModel &cam, Point p)
+        {
+            float x, y;
+            cam.undistort((p.x - cam.cx) / cam.fx, (p.y - cam.cy) / cam.fy, x, y);
+            return Point{x * cam.fx + cam.cx, y * cam.fy + cam.cy};
+        }
+
+        inline Point distort_point(const CameraModel &cam, Point p)
+        {
+            float x, y;
+            cam.distort((p.x - cam.cx) / cam.fx, (p.y - cam.cy) / cam.fy, x, y);
+            return Point{x * cam.fx + cam.cx, y * cam.fy + cam.cy};
+        }
+
+        // 连通域质心
+        inline size_t undistort_centroids(const CameraModel &cam, const stream::Blob *blobs, size_t count, Point *out)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                out[i] = undistort_point(cam, Point{blobs[i].cx(), blobs[i].cy()});
+            }
+            return count;
+        }
+
+        // 整帧重映射表：每个输出像素对应源图像中的一个 12.4 定点坐标（x、y 各一个 uint16_t），
+        // 小数部分就是双线性插值的权重（1/16 精度）。落在源图像外的像素标记为 INVALID。
+        // 表只在相机参数变化时生成一次；应用时按行顺序遍历输出，与 interpolation::nearest_neighbor 相同。
+        template <size_t WIDTH, size_t HEIGHT>
+        class RemapTable
+        {
+        public:
+            static_assert(WIDTH < 4096 && HEIGHT < 4096, "12.4 fixed-point coordinates need width/height < 4096");
+            static constexpr uint16_t INVALID = 0xFFFF;
+            static constexpr int FRAC_BITS = 4;
+            static constexpr int ONE = 1 << FRAC_BITS;
+
+            struct Entry
+            {
+                uint16_t x;
+                uint16_t y;
+            };
+
+            // 输出图像使用与源图像相同的内参
+            void build(const CameraModel &cam)
+            {
+                build(cam, cam);
+            }
+
+            // out: 输出（无畸变）图像的内参，可以用来缩放视场
+            void build(const CameraModel &cam, const CameraModel &out)
+            {
+                const float max_x = static_cast<float>((WIDTH - 1) * ONE);
+                const float max_y = static_cast<float>((HEIGHT - 1) * ONE);
+                valid_count_ = 0;
+                for (size_t v = 0; v < HEIGHT; ++v)
+                {
+                    for (size_t u = 0; u < WIDTH; ++u)
+                    {
+                        float xd, yd;
+                        cam.distort((u - out.cx) / out.fx, (v - out.cy) / out.fy, xd, yd);
+                        float sx = std::round((xd * cam.fx + cam.cx) * ONE);
+                        float sy = std::round((yd * cam.fy + cam.cy) * ONE);
+                        Entry &e = table_[v * WIDTH + u];
+                        if (sx < 0 || sy < 0 || sx > max_x || sy > max_y)
+                        {
+                            e = Entry{INVALID, INVALID};
+                            continue;
+                        }
+                        e = Entry{static_cast<uint16_t>(sx), static_cast<uint16_t>(sy)};
+                        valid_count_++;
+                    }
+                }
+            }
+
+            const Entry &entry(size_t x, size_t y) const { return table_[y * WIDTH + x]; }
+            size_t valid_count() const { return valid_count_; }
+
+            // 灰度/RGB/RGB565 双线性插值，其他格式（二值、LAB、HSV 等）取最近邻
+            template <PixelFormat PF, typename SrcDerived, typename DstDerived>
+            void apply(const ImageBase<PF, WIDTH, HEIGHT, SrcDerived> &src, ImageBase<PF, WIDTH, HEIGHT, DstDerived> &dst,
+                       typename PixelFormatTrait<PF>::type fill = {}) const
+            {
+                const SrcDerived &s = static_cast<const SrcDerived &>(src);
+                for (size_t y = 0; y < HEIGHT; ++y)
+                {
+                    const Entry *row = &table_[y * WIDTH];
+                    for (size_t x = 0; x < WIDTH; ++x)
+                    {
+                        const Entry e = row[x];
+                        if (e.x == INVALID)
+                        {
+                            dst(x, y) = fill;
+                            continue;
+                        }
+                        dst(x, y) = sample(s, e);
+                    }
+                }
+            }
+
+        private:
+            static void corners(const Entry &e, size_t &x0, size_t &y0, size_t &x1, size_t &y1, uint32_t w[4])
+            {
+                x0 = e.x >> FRAC_BITS;
+                y0 = e.y >> FRAC_BITS;
+                x1 = x0 + 1 < WIDTH ? x0 + 1 : x0;
+                y1 = y0 + 1 < HEIGHT ? y0 + 1 : y0;
+                uint32_t fx = e.x & (ONE - 1), fy = e.y & (ONE - 1);
+                w[0] = (ONE - fx) * (ONE - fy);
+                w[1] = fx * (ONE - fy);
+                w[2] = (ONE - fx) * fy;
+                w[3] = fx * fy;
+            }
+
+            static uint8_t blend(uint32_t a, uint32_t b, uint32_t c, uint32_t d, const uint32_t w[4])
+            {
+                return static_cast<uint8_t>((a * w[0] + b * w[1] + c * w[2] + d * w[3] + ONE * ONE / 2) >> (2 * FRAC_BITS));
+            }
+
+            template <typename Src>
+            static auto sample(const Src &src, const Entry &e)
+                -> std::enable_if_t<Src::pixel_format == PixelFormat::Grayscale, GrayscalePixel>
+            {
+                size_t x0, y0, x1, y1;
+                uint32_t w[4];
+                corners(e, x0, y0, x1, y1, w);
+                return GrayscalePixel{blend(src(x0, y0).value, src(x1, y0).value, src(x0, y1).value, src(x1, y1).value, w)};
+            }
+
+            template <typename Src>
+            static auto sample(const Src &src, const Entry &e)
+                -> std::enable_if_t<Src::pixel_format == PixelFormat::RGB, RGBPixel>
+            {
+                size_t x0, y0, x1, y1;
+                uint32_t w[4];
+                corners(e, x0, y0, x1, y1, w);
+                const RGBPixel &a = src(x0, y0), &b = src(x1, y0), &c = src(x0, y1), &d = src(x1, y1);
+                return RGBPixel{blend(a.r, b.r, c.r, d.r, w), blend(a.g, b.g, c.g, d.g, w), blend(a.b, b.b, c.b, d.b, w)};
+            }
+
+            template <typename Src>
+            static auto sample(const Src &src, const Entry &e)
+                -> std::enable_if_t<Src::pixel_format == PixelFormat::RGB565, RGB565Pixel>
+            {
+                size_t x0, y0, x1, y1;
+                uint32_t w[4];
+                corners(e, x0, y0, x1, y1, w);
+                const RGB565Pixel a = src(x0, y0), b = src(x1, y0), c = src(x0, y1), d = src(x1, y1);
+                RGB565Pixel out;
+                out.r = blend(a.r, b.r, c.r, d.r, w);
+                out.g = blend(a.g, b.g, c.g, d.g, w);
+                out.b = blend(a.b, b.b, c.b, d.b, w);
+                return out;
+            }
+
+            template <typename Src>
+            static auto sample(const Src &src, const Entry &e)
+                -> std::enable_if_t<Src::pixel_format != PixelFormat::Grayscale && Src::pixel_format != PixelFormat::RGB &&
+                                        Src::pixel_format != PixelFormat::RGB565,
+                                    typename Src::PixelT>
+            {
+                size_t x = (e.x + ONE / 2) >> FRAC_BITS;
+                size_t y = (e.y + ONE / 2) >> FRAC_BITS;
+                return src(x < WIDTH ? x : WIDTH - 1, y < HEIGHT ? y : HEIGHT - 1);
+            }
+
+            Entry table_[WIDTH * HEIGHT];
+            size_t valid_count_ = 0;
+        };
+
+    }
+}
@@ -0,0 +1,47 @@
+import struct
+import sys
+
+FORMAT_RGB565 = 2
+FRAME_ALIGN = 64
+
+def align_up(v, a):
+    return (v + a - 1) // a * a
+
+def pack_rgb565_frames(bin_paths, output_path, width=320, height=240, frame_interval_us=33333):
+    frame_bytes = width * height * 2
+    frame_stride = align_up(frame_bytes, FRAME_ALIGN)
+    offset = align_up(64, FRAME_ALIGN)
+    index = []
+
+    with open(output_path, 'wb') as f:
+        f.write(b'\0' * offset)
+        for i, path in enumerate(bin_paths):
+            with open(path, 'rb') as src:
+                data = src.read()
+            if len(data) != frame_bytes:
+                print(f"{path}: size mismatch, expected {frame_bytes} bytes, got {len(data)}")
+                continue
+            # raw_to_rgb565 reads big-endian words; store them in host (little-endian) order
+            swapped = bytearray(frame_bytes)
+            swapped[0::2] = data[1::2]
+            swapped[1::2] = data[0::2]
+            f.write(swapped)
+            f.write(b'\0' * (frame_stride - frame_bytes))
+            index.append((offset, i * frame_interval_us))
+            offset += frame_stride
+
+        for entry in index:
+            f.write(struct.pack('<QQ', *entry))
+
+        header = b'DVREC\0\0\0' + struct.pack('<IIIIIIQQ', 1, FORMAT_RGB565, width, height,
+                                              frame_bytes, frame_stride, len(index), offset)
+        f.seek(0)
+        f.write(header.ljust(64, b'\0'))
+
+    print(f"Packed {len(index)} frames into: {output_path}")
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        print("usage: pack_recording.py out.dvr frame0.bin [frame1.bin ...]")
+        sys.exit(1)
+    pack_rgb565_frames(sys.argv[2:], sys.argv[1])
@@ -0,0 +1,135 @@
+#include <iostream>
+#include <cstring>
+#include <chrono>
+
+#include <dv.hpp>
+#include <dv/recording.hpp>
+#include <time.h>
+
+using dv::pixel_format::PixelFormat;
+using dv::recording::DropPolicy;
+
+static dv::image::Image<PixelFormat::RGB565, 320, 240> img_rgb565;
+
+// 每帧的前 4 个字节写入帧号，回放时据此检查顺序和内容
+static void stamp(uint32_t id)
+{
+    std::memcpy(img_rgb565.get_data_ptr(), &id, sizeof(id));
+}
+
+static bool record(const char *path, size_t frames, size_t ring, DropPolicy policy, size_t batch)
+{
+    dv::recording::AsyncRecordingWriter writer;
+    if (!writer.open<PixelFormat::RGB565, 320, 240>(path, ring, policy, batch))
+    {
+        std::cerr << "Failed to open " << path << " for writing" << std::endl;
+        return false;
+    }
+    double worst = 0;
+    auto time_0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < frames; ++i)
+    {
+        stamp(static_cast<uint32_t>(i));
+        auto t0 = std::chrono::steady_clock::now();
+        writer.write(img_rgb565, i * 33333);
+        auto t1 = std::chrono::steady_clock::now();
+        worst = std::max(worst, std::chrono::duration<double>(t1 - t0).count());
+    }
+    auto time_1 = std::chrono::steady_clock::now();
+    if (!writer.close())
+    {
+        std::cerr << "Failed to finish " << path << std::endl;
+        return false;
+    }
+    std::cout << "Submitted " << frames << " frames in " << std::chrono::duration<double>(time_1 - time_0).count()
+              << " seconds (worst write() " << worst << " seconds): accepted " << writer.accepted() << ", written "
+              << writer.written() << ", dropped " << writer.dropped() << std::endl;
+    if (writer.written() + writer.dropped() != frames || writer.queued() != 0 ||
+        writer.accepted() < writer.written() || writer.accepted() > frames)
+    {
+        std::cerr << "Frame counters do not add up" << std::endl;
+        return false;
+    }
+
+    // 回放：帧数与 written() 相同，帧号和时间戳严格递增，内容与原图一致
+    dv::recording::RecordingReader reader;
+    if (!reader.open(path) || reader.frame_count() != writer.written())
+    {
+        std::cerr << "Failed to replay " << path << std::endl;
+        return false;
+    }
+    int64_t last = -1;
+    const uint8_t *expected = static_cast<const uint8_t *>(img_rgb565.get_data_ptr());
+    for (size_t i = 0; i < reader.frame_count(); ++i)
+    {
+        dv::image::ImageView<PixelFormat::RGB565, 320, 240> view;
+        uint32_t id;
+        if (!reader.frame(i, view))
+            return false;
+        std::memcpy(&id, view.get_data_ptr(), sizeof(id));
+        if (static_cast<int64_t>(id) <= last || reader.timestamp(i) != id * 33333ull ||
+            std::memcmp(static_cast<const uint8_t *>(view.get_data_ptr()) + 4, expected + 4, view.get_data_size() - 4) != 0)
+        {
+            std::cerr << "Frame " << i << " out of order or corrupted" << std::endl;
+            return false;
+        }
+        last = id;
+    }
+    // 最旧优先丢弃时最新的帧一定在
+    if (policy == DropPolicy::Oldest && last != static_cast<int64_t>(frames - 1))
+    {
+        std::cerr << "Newest frame missing with DropPolicy::Oldest" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    delete[] raw_data;
+
+    // 足够大的环：不丢帧
+    if (!record("async.dvr", 300, 300, DropPolicy::Newest, 16))
+        return -1;
+    // 小环、突发写入：按两种策略丢帧
+    if (!record("async_newest.dvr", 600, 4, DropPolicy::Newest, 2) ||
+        !record("async_oldest.dvr", 600, 4, DropPolicy::Oldest, 2))
+        return -1;
+
+    // 流式处理得到的打包二值掩码
+    dv::recording::AsyncRecordingWriter mask_writer;
+    auto gray = dv::image::Image<PixelFormat::Grayscale, 320, 240>();
+    auto mask = dv::image::Image<PixelFormat::Binary, 320, 240>();
+    dv::image::image_cast(img_rgb565, gray);
+    dv::binaryzation::otsu(gray, mask);
+    if (!mask_writer.open<PixelFormat::Binary, 320, 240>("async_mask.dvr"))
+        return -1;
+    for (size_t i = 0; i < 10; ++i)
+        mask_writer.write_raw(mask.get_data_ptr(), i);
+    if (!mask_writer.close() || mask_writer.written() != 10)
+    {
+        std::cerr << "Mask recording failed" << std::endl;
+        return -1;
+    }
+    dv::recording::RecordingReader reader;
+    dv::image::ImageView<PixelFormat::Binary, 320, 240> view;
+    if (!reader.open("async_mask.dvr") || !reader.frame(9, view) ||
+        std::memcmp(view.get_data_ptr(), mask.get_data_ptr(), mask.get_data_size()) != 0)
+    {
+        std::cerr << "Mask replay mismatch" << std::endl;
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <dv.hpp>
+#include <dv/batch.hpp>
+
+using dv::pixel_format::PixelFormat;
+using dv::image::Image;
+
+constexpr size_t STREAMS = 4;
+
+template <PixelFormat PF, size_t W, size_t H>
+static bool same(const Image<PF, W, H> &a, const Image<PF, W, H> &b)
+{
+    return std::memcmp(a.get_data_ptr(), b.get_data_ptr(), a.get_data_size()) == 0;
+}
+
+template <size_t W, size_t H>
+static size_t foreground(const Image<PixelFormat::Binary, W, H> &mask)
+{
+    size_t n = 0;
+    for (size_t y = 0; y < H; ++y)
+        for (size_t x = 0; x < W; ++x)
+            n += mask(x, y).value != 0;
+    return n;
+}
+
+// 共享的机器上单次计时波动很大，取若干次中最快的一次
+template <typename Fn>
+static double best_seconds(Fn fn)
+{
+    double best = 0;
+    for (int r = 0; r < 10; ++r)
+    {
+        auto time_0 = std::chrono::steady_clock::now();
+        fn();
+        auto time_1 = std::chrono::steady_clock::now();
+        double t = std::chrono::duration<double>(time_1 - time_0).count();
+        if (r == 0 || t < best)
+            best = t;
+    }
+    return best;
+}
+
+// 四路：原图、水平翻转、垂直翻转、旋转 180 度
+static Image<PixelFormat::RGB565, 320, 240> rgb565[STREAMS];
+static Image<PixelFormat::LAB, 320, 240> lab[STREAMS], lab_ref[STREAMS];
+static Image<PixelFormat::Grayscale, 320, 240> gray[STREAMS], gray_ref[STREAMS];
+static Image<PixelFormat::Binary, 320, 240> mask[STREAMS], mask_ref[STREAMS];
+
+static bool check(size_t threads)
+{
+    dv::batch::BatchProcessor<320, 240> batch(threads);
+    const Image<PixelFormat::RGB565, 320, 240> *src[STREAMS];
+    const Image<PixelFormat::LAB, 320, 240> *lab_src[STREAMS];
+    const Image<PixelFormat::Grayscale, 320, 240> *gray_src[STREAMS];
+    Image<PixelFormat::LAB, 320, 240> *lab_dst[STREAMS];
+    Image<PixelFormat::Grayscale, 320, 240> *gray_dst[STREAMS];
+    Image<PixelFormat::Binary, 320, 240> *mask_dst[STREAMS];
+    for (size_t s = 0; s < STREAMS; ++s)
+    {
+        src[s] = &rgb565[s];
+        lab_src[s] = &lab[s];
+        gray_src[s] = &gray[s];
+        lab_dst[s] = &lab[s];
+        gray_dst[s] = &gray[s];
+        mask_dst[s] = &mask[s];
+    }
+
+    // 路数从 1 到 4，覆盖路数少于、等于、多于线程数的情况
+    for (size_t count = 1; count <= STREAMS; ++count)
+    {
+        for (size_t s = 0; s < STREAMS; ++s)
+        {
+            std::memset(lab[s].get_data_ptr(), 0, lab[s].get_data_size());
+            std::memset(gray[s].get_data_ptr(), 0, gray[s].get_data_size());
+        }
+        batch.image_cast(src, lab_dst, count);
+        batch.image_cast(src, gray_dst, count);
+        for (size_t s = 0; s < count; ++s)
+        {
+            if (!same(lab[s], lab_ref[s]) || !same(gray[s], gray_ref[s]))
+            {
+                std::cerr << threads << " threads, " << count << " streams: image_cast mismatch on stream " << s << std::endl;
+                return false;
+            }
+        }
+
+        const dv::pixel_format::LABPixel t_low{30, -128, 0};
+        const dv::pixel_format::LABPixel t_high{100, -20, 127};
+        dv::batch::StreamResult results[STREAMS];
+        batch.threshold(lab_src, mask_dst, count, t_low, t_high, results);
+        for (size_t s = 0; s < count; ++s)
+        {
+            dv::binaryzation::threshold(lab[s], mask_ref[s], t_low, t_high);
+            if (!same(mask[s], mask_ref[s]) || results[s].foreground != foreground(mask_ref[s]))
+            {
+                std::cerr << threads << " threads, " << count << " streams: threshold mismatch on stream " << s << std::endl;
+                return false;
+            }
+        }
+
+        batch.otsu(gray_src, mask_dst, count, results);
+        for (size_t s = 0; s < count; ++s)
+        {
+            dv::binaryzation::otsu(gray[s], mask_ref[s]);
+            size_t hist[dv::binaryzation::OTSU_HIST_SIZE] = {0};
+            for (size_t y = 0; y < 240; ++y)
+                for (size_t x = 0; x < 320; ++x)
+                    hist[gray[s](x, y).value]++;
+            uint8_t t = dv::binaryzation::otsu_threshold(hist, 320 * 240);
+            if (!same(mask[s], mask_ref[s]) || results[s].threshold != t || results[s].foreground != foreground(mask_ref[s]))
+            {
+                std::cerr << threads << " threads, " << count << " streams: otsu mismatch on stream " << s << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+
+    dv::image::raw_to_rgb565(raw_data, rgb565[0]);
+    dv::transform::flip_horizontal(rgb565[0], rgb565[1]);
+    dv::transform::flip_vertical(rgb565[0], rgb565[2]);
+    dv::transform::rotate180(rgb565[0], rgb565[3]);
+    for (size_t s = 0; s < STREAMS; ++s)
+    {
+        dv::image::image_cast(rgb565[s], lab_ref[s]);
+        dv::image::image_cast(rgb565[s], gray_ref[s]);
+    }
+
+    if (!check(1) || !check(2) || !check(3) || !check(4))
+        return -1;
+
+    // 宽度不是 8 的倍数，行带边界处二值图的字节不能被两个线程同时写
+    {
+        static Image<PixelFormat::Grayscale, 37, 21> odd[2];
+        static Image<PixelFormat::Binary, 37, 21> odd_mask[2], odd_ref;
+        for (auto &img : odd)
+            for (size_t y = 0; y < 21; ++y)
+                for (size_t x = 0; x < 37; ++x)
+                    img(x, y) = dv::pixel_format::GrayscalePixel{static_cast<uint8_t>(std::rand())};
+        const Image<PixelFormat::Grayscale, 37, 21> *src[2] = {&odd[0], &odd[1]};
+        Image<PixelFormat::Binary, 37, 21> *dst[2] = {&odd_mask[0], &odd_mask[1]};
+        dv::batch::BatchProcessor<37, 21, 2> batch(4);
+        dv::batch::StreamResult results[2];
+        batch.otsu(src, dst, 2, results);
+        for (size_t s = 0; s < 2; ++s)
+        {
+            dv::binaryzation::otsu(odd[s], odd_ref);
+            if (!same(odd_mask[s], odd_ref) || results[s].foreground != foreground(odd_ref))
+            {
+                std::cerr << "Odd-width otsu mismatch on stream " << s << std::endl;
+                return -1;
+            }
+        }
+    }
+
+    // 计时：逐路调用与 1..硬件线程数的批处理。多线程时 clock() 累加所有线程的 CPU 时间，这里统一用墙钟时间
+    const Image<PixelFormat::RGB565, 320, 240> *src[STREAMS];
+    Image<PixelFormat::LAB, 320, 240> *lab_dst[STREAMS];
+    const Image<PixelFormat::LAB, 320, 240> *lab_src[STREAMS];
+    Image<PixelFormat::Binary, 320, 240> *mask_dst[STREAMS];
+    for (size_t s = 0; s < STREAMS; ++s)
+    {
+        src[s] = &rgb565[s];
+        lab_dst[s] = &lab[s];
+        lab_src[s] = &lab[s];
+        mask_dst[s] = &mask[s];
+    }
+    const dv::pixel_format::LABPixel t_low{30, -128, 0};
+    const dv::pixel_format::LABPixel t_high{100, -20, 127};
+    const int rounds = 20;
+    const double frames = double(STREAMS) * rounds;
+
+    const double sequential = best_seconds([&]
+                                           {
+                                               for (int i = 0; i < rounds; ++i)
+                                               {
+                                                   for (size_t s = 0; s < STREAMS; ++s)
+                                                   {
+                                                       dv::image::image_cast(rgb565[s], lab[s]);
+                                                       dv::binaryzation::threshold(lab[s], mask[s], t_low, t_high);
+                                                   }
+                                               } });
+    std::cout << STREAMS << " streams, sequential: " << frames / sequential << " frames/s" << std::endl;
+
+    const size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= max_threads; ++threads)
+    {
+        dv::batch::BatchProcessor<320, 240> batch(threads);
+        // 第一轮唤醒工作线程，不计时
+        batch.image_cast(src, lab_dst, STREAMS);
+        const double batched = best_seconds([&]
+                                            {
+                                                for (int i = 0; i < rounds; ++i)
+                                                {
+                                                    batch.image_cast(src, lab_dst, STREAMS);
+                                                    batch.threshold(lab_src, mask_dst, STREAMS, t_low, t_high);
+                                                } });
+        std::cout << "  " << threads << " threads: " << frames / batched << " frames/s (" << sequential / batched
+                  << "x sequential)" << std::endl;
+    }
+
+    delete[] raw_data;
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <cstring>
+
+#include <dv.hpp>
+#include <time.h>
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+
+    using dv::pixel_format::PixelFormat;
+
+    static dv::color::ColorCorrection cc;
+
+    // 默认参数是恒等变换
+    for (uint32_t i = 0; i <= 0xFFFF; ++i)
+    {
+        if (cc.map(static_cast<uint16_t>(i)) != i)
+        {
+            std::cerr << "Identity correction changed pixel " << i << std::endl;
+            return -1;
+        }
+    }
+
+    dv::image::Image<PixelFormat::RGB565, 320, 240> img_rgb565;
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+
+    const float matrix[9] = {1.2f, -0.1f, -0.1f,
+                             -0.05f, 1.1f, -0.05f,
+                             0.0f, -0.2f, 1.2f};
+    cc.gray_world(img_rgb565);
+    cc.set_matrix(matrix);
+    cc.set_gamma(2.2f);
+    auto time_0 = clock();
+    cc.update();
+    auto time_1 = clock();
+    cc.apply(img_rgb565);
+    auto time_2 = clock();
+    std::cout << "Table update " << double(time_1 - time_0) / CLOCKS_PER_SEC << " seconds, apply "
+              << double(time_2 - time_1) / CLOCKS_PER_SEC << " seconds" << std::endl;
+
+    // 读入时校正与读入后原地校正结果相同
+    dv::image::Image<PixelFormat::RGB565, 320, 240> fused;
+    dv::color::raw_to_rgb565(raw_data, fused, cc);
+    delete[] raw_data;
+    if (std::memcmp(fused.get_data_ptr(), img_rgb565.get_data_ptr(), fused.get_data_size()) != 0)
+    {
+        std::cerr << "Fused correction mismatch" << std::endl;
+        return -1;
+    }
+
+    // 纯白经过增益为 1 的矩阵（行和为 1）仍然是白
+    cc.reset();
+    cc.set_matrix(matrix);
+    cc.update();
+    if (cc.map(static_cast<uint16_t>(0xFFFF)) != 0xFFFF || cc.map(static_cast<uint16_t>(0)) != 0)
+    {
+        std::cerr << "White/black point moved" << std::endl;
+        return -1;
+    }
+
+    file = fopen("out.bin", "wb");
+    if (!file)
+    {
+        std::cerr << "Failed to open out.bin for writing" << std::endl;
+        return -1;
+    }
+    uint8_t *out = new uint8_t[320 * 240 * 2];
+    dv::image::rgb565_to_raw(img_rgb565, out);
+    fwrite(out, 1, 320 * 240 * 2, file);
+    fclose(file);
+    delete[] out;
+    return 0;
+}
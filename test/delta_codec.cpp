@@ -0,0 +1,77 @@
+#include <iostream>
+#include <cstring>
+
+#include <dv.hpp>
+#include <time.h>
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    const size_t width = 320;
+    const size_t height = 240;
+    uint8_t *raw_data = new uint8_t[width * height * 2];
+    fread(raw_data, 1, width * height * 2, file);
+    fclose(file);
+
+    dv::image::Image<dv::pixel_format::PixelFormat::RGB565, 320, 240> img_rgb565;
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    delete[] raw_data;
+    std::cout << "Image loaded: " << img_rgb565.width() << "x" << img_rgb565.height() << std::endl;
+
+    constexpr size_t max_size = dv::codec::delta_max_encoded_size<320, 240>();
+    uint8_t *encoded = new uint8_t[max_size];
+    auto frame = dv::image::Image<dv::pixel_format::PixelFormat::RGB565, 320, 240>();
+    auto decoded = dv::image::Image<dv::pixel_format::PixelFormat::RGB565, 320, 240>();
+    dv::codec::DeltaEncoder<320, 240> encoder(100);
+    dv::codec::DeltaDecoder<320, 240> decoder;
+    dv::codec::CodecStats stats;
+
+    double encode_secs = 0;
+    for (int i = 0; i < 300; i++)
+    {
+        // 模拟一个在静止背景上移动的目标
+        dv::image::copy(img_rgb565, frame);
+        dv::draw::filled_circle(frame, 20 + i % 280, 120, 10, dv::pixel_format::RGB565Pixel{0, 63, 0});
+
+        auto time_0 = clock();
+        size_t size = encoder.encode(frame, encoded, max_size);
+        encode_secs += double(clock() - time_0) / CLOCKS_PER_SEC;
+        stats.record(frame.get_data_size(), size);
+
+        if (!decoder.decode(encoded, size, decoded) ||
+            std::memcmp(decoded.get_data_ptr(), frame.get_data_ptr(), frame.get_data_size()) != 0)
+        {
+            std::cerr << "Frame " << i << " mismatch" << std::endl;
+            return -1;
+        }
+    }
+    delete[] encoded;
+
+    // 码流与主机字节序无关：掩码和 XOR 值都按大端写入
+    {
+        static dv::image::Image<dv::pixel_format::PixelFormat::RGB565, 64, 4> small;
+        std::memset(small.get_data_ptr(), 0, small.get_data_size());
+        dv::codec::DeltaEncoder<64, 4> small_encoder;
+        uint8_t bytes[dv::codec::delta_max_encoded_size<64, 4>()];
+        small_encoder.encode(small, bytes, sizeof(bytes));
+        static_cast<uint16_t *>(small.get_data_ptr())[3] = 0x1234;
+        size_t size = small_encoder.encode(small, bytes, sizeof(bytes));
+        const uint8_t expected[] = {dv::codec::FRAME_DELTA, 0x01, 0x00, 0x00, 0x00, 0x08, 0x12, 0x34};
+        if (size != sizeof(expected) || std::memcmp(bytes, expected, size) != 0)
+        {
+            std::cerr << "Delta frame byte layout mismatch" << std::endl;
+            return -1;
+        }
+    }
+
+    std::cout << "Encoded frames: " << stats.bytes_per_frame() << " bytes per frame (ratio " << stats.ratio() << ")" << std::endl;
+    std::cout << "Time taken for encoding: " << encode_secs / stats.frames << " seconds." << std::endl;
+    return 0;
+}
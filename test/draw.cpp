@@ -0,0 +1,209 @@
+#include <iostream>
+#include <cstring>
+
+#include <dv.hpp>
+#include <time.h>
+
+using dv::pixel_format::PixelFormat;
+using dv::pixel_format::GrayscalePixel;
+using dv::image::Image;
+using Font = dv::draw::SimpleBitmapFont;
+
+static Image<PixelFormat::Grayscale, 320, 240> ref;
+static Image<PixelFormat::Grayscale, 320, 240> out;
+
+// 逐位绘制的参考实现（与字模缓存之前的 char_draw 相同）
+static void ref_char(int x, int y, char ch, GrayscalePixel color, int scale)
+{
+    int idx = static_cast<int>(static_cast<unsigned char>(ch)) - Font::first_char;
+    if (idx < 0 || idx >= static_cast<int>(Font::glyph_count))
+        return;
+    for (int row = 0; row < Font::glyph_rows; row++)
+        for (int col = 0; col < Font::char_width; col++)
+            if (Font::font_data[idx][row] & (1 << (Font::char_width - 1 - col)))
+                for (int sy = 0; sy < scale; sy++)
+                    for (int sx = 0; sx < scale; sx++)
+                        dv::draw::point(ref, x + col * scale + sx, y + row * scale + sy, color);
+}
+
+static void ref_text(int x, int y, const char *text, GrayscalePixel color, int scale)
+{
+    int cur_x = x;
+    for (const char *p = text; *p != '\0'; p++)
+    {
+        if (*p == '\n')
+        {
+            cur_x = x;
+            y += (Font::char_height + 1) * scale;
+            continue;
+        }
+        ref_char(cur_x, y, *p, color, scale);
+        cur_x += (Font::char_width + 1) * scale;
+    }
+}
+
+static void clear()
+{
+    std::memset(ref.get_data_ptr(), 0, ref.get_data_size());
+    std::memset(out.get_data_ptr(), 0, out.get_data_size());
+}
+
+static bool same()
+{
+    return std::memcmp(ref.get_data_ptr(), out.get_data_ptr(), ref.get_data_size()) == 0;
+}
+
+static bool check_fixed(int32_t value, int decimals, const char *expected)
+{
+    dv::draw::HudText<PixelFormat::Grayscale> hud;
+    int id = hud.add(0, 0, GrayscalePixel{255}, "V:");
+    hud.set_fixed(id, value, decimals);
+    if (std::strcmp(hud.str(id) + 2, expected) != 0)
+    {
+        std::cerr << "set_fixed(" << value << ", " << decimals << ") gave \"" << hud.str(id) + 2
+                  << "\", expected \"" << expected << "\"" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    // 所有可打印 ASCII，每行 32 个字符
+    char printable[128];
+    size_t n = 0;
+    for (int c = ' '; c <= '~'; ++c)
+    {
+        printable[n++] = static_cast<char>(c);
+        if ((c - ' ') % 32 == 31)
+            printable[n++] = '\n';
+    }
+    printable[n] = '\0';
+
+    // 各种缩放倍数（5 走通用路径），原点包括左上、右下越界的位置
+    const int origins[][2] = {{0, 0}, {3, 5}, {-4, -3}, {-20, 100}, {300, 230}, {150, -10}};
+    for (int scale = 1; scale <= 5; ++scale)
+    {
+        for (const auto &o : origins)
+        {
+            clear();
+            ref_text(o[0], o[1], printable, GrayscalePixel{200}, scale);
+            dv::draw::text(out, o[0], o[1], printable, GrayscalePixel{200}, scale);
+            if (!same())
+            {
+                std::cerr << "text() mismatch at scale " << scale << ", origin (" << o[0] << ", " << o[1] << ")" << std::endl;
+                return -1;
+            }
+            // char_draw 逐个字符
+            clear();
+            for (int c = ' '; c <= '~'; ++c)
+            {
+                int x = o[0] + (c - ' ') % 16 * 6 * scale, y = o[1] + (c - ' ') / 16 * 8 * scale;
+                ref_char(x, y, static_cast<char>(c), GrayscalePixel{90}, scale);
+                dv::draw::char_draw(out, x, y, static_cast<char>(c), GrayscalePixel{90}, scale);
+            }
+            if (!same())
+            {
+                std::cerr << "char_draw() mismatch at scale " << scale << ", origin (" << o[0] << ", " << o[1] << ")" << std::endl;
+                return -1;
+            }
+        }
+    }
+
+    // 字模缓存：每个可打印字符都有字模，范围外为空
+    const auto &cache = dv::draw::GlyphCache<Font, 2>::instance();
+    if (!cache.find('a') || !cache.find('~') || cache.find('\x7f') || cache.find('\x1f') || cache.find('\xc8'))
+    {
+        std::cerr << "Glyph cache range mismatch" << std::endl;
+        return -1;
+    }
+
+    // HUD 数值格式
+    if (!check_fixed(5, 2, "0.05") || !check_fixed(-1234, 3, "-1.234") || !check_fixed(1234, 2, "12.34") ||
+        !check_fixed(-5, 2, "-0.05") || !check_fixed(0, 0, "0") || !check_fixed(-2147483647 - 1, 0, "-2147483648") ||
+        !check_fixed(100, 2, "1.00"))
+        return -1;
+
+    // HUD 渲染与直接调用 text() 相同，包围盒覆盖绘制范围
+    dv::draw::HudText<PixelFormat::Grayscale, 4, 12, 2> hud;
+    int fps = hud.add(4, 4, GrayscalePixel{255}, "FPS ");
+    int err = hud.add(-6, 220, GrayscalePixel{128}, "err=");
+    hud.set_int(fps, 120);
+    hud.set_fixed(err, -375, 2);
+    clear();
+    ref_text(4, 4, "FPS 120", GrayscalePixel{255}, 2);
+    ref_text(-6, 220, "err=-3.75", GrayscalePixel{128}, 2);
+    hud.render(out);
+    if (!same())
+    {
+        std::cerr << "HudText render mismatch" << std::endl;
+        return -1;
+    }
+    // 超出 MAX_CHARS 的内容被截断
+    hud.set_text(err, "0123456789");
+    if (std::strcmp(hud.str(err), "err=01234567") != 0)
+    {
+        std::cerr << "HudText truncation mismatch: " << hud.str(err) << std::endl;
+        return -1;
+    }
+    int x0, y0, x1, y1;
+    if (!hud.bounds(fps, x0, y0, x1, y1) || x0 != 4 || y0 != 4 || x1 != 4 + 7 * 12 || y1 != 4 + 10)
+    {
+        std::cerr << "HudText bounds mismatch" << std::endl;
+        return -1;
+    }
+    if (hud.bounds(2, x0, y0, x1, y1) || hud.bounds(-1, x0, y0, x1, y1) || x0 || y0 || x1 || y1 || hud.str(5))
+    {
+        std::cerr << "HudText accepted an invalid id" << std::endl;
+        return -1;
+    }
+
+    // 行指针 span 与逐像素写入一致，包括裁剪；二值图走逐像素路径
+    {
+        static Image<PixelFormat::RGB565, 320, 240> rgb_span, rgb_ref;
+        static Image<PixelFormat::Binary, 320, 240> bin_span, bin_ref;
+        const dv::pixel_format::RGB565Pixel c565{3, 40, 17};
+        const dv::pixel_format::BinaryPixel on{255};
+        const int spans[][3] = {{10, 50, 5}, {-20, 30, 0}, {300, 400, 239}, {-5, 500, 120}, {40, 40, 7}, {60, 20, 8},
+                                {0, 10, -1}, {0, 10, 240}};
+        for (const auto &sp : spans)
+        {
+            dv::draw::hline(rgb_span, sp[0], sp[1], sp[2], c565);
+            dv::draw::hline(bin_span, sp[0], sp[1], sp[2], on);
+            for (int x = sp[0]; x < sp[1]; ++x)
+            {
+                dv::draw::point(rgb_ref, x, sp[2], c565);
+                dv::draw::point(bin_ref, x, sp[2], on);
+            }
+        }
+        dv::draw::filled_rect(rgb_span, 250, 200, 400, 260, c565);
+        dv::draw::filled_rect(bin_span, 250, 200, 400, 260, on);
+        for (int y = 200; y <= 260; ++y)
+            for (int x = 250; x <= 400; ++x)
+            {
+                dv::draw::point(rgb_ref, x, y, c565);
+                dv::draw::point(bin_ref, x, y, on);
+            }
+        if (std::memcmp(rgb_span.get_data_ptr(), rgb_ref.get_data_ptr(), rgb_ref.get_data_size()) != 0 ||
+            std::memcmp(bin_span.get_data_ptr(), bin_ref.get_data_ptr(), bin_ref.get_data_size()) != 0)
+        {
+            std::cerr << "hline/filled_rect mismatch" << std::endl;
+            return -1;
+        }
+    }
+
+    // 计时：逐位绘制与字模缓存
+    const int rounds = 200;
+    auto time_0 = clock();
+    for (int i = 0; i < rounds; ++i)
+        ref_text(0, 0, printable, GrayscalePixel{200}, 2);
+    auto time_1 = clock();
+    for (int i = 0; i < rounds; ++i)
+        dv::draw::text(out, 0, 0, printable, GrayscalePixel{200}, 2);
+    auto time_2 = clock();
+    std::cout << "Text at scale 2: per-bit " << double(time_1 - time_0) / CLOCKS_PER_SEC / rounds
+              << " seconds, glyph cache " << double(time_2 - time_1) / CLOCKS_PER_SEC / rounds << " seconds" << std::endl;
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+#include <dv.hpp>
+#include <time.h>
+
+using dv::pixel_format::PixelFormat;
+using dv::gradient::Kernel;
+
+static dv::gradient::Gradient<320, 240> grad;
+
+// 逐像素的参照实现
+template <Kernel K>
+static bool check_gradient(const dv::image::Image<PixelFormat::Grayscale, 320, 240> &gray)
+{
+    constexpr int A = dv::gradient::KernelWeights<K>::outer;
+    constexpr int B = dv::gradient::KernelWeights<K>::center;
+    grad.compute<K>(gray);
+    for (int y = 0; y < 240; ++y)
+    {
+        for (int x = 0; x < 320; ++x)
+        {
+            int dx = 0, dy = 0;
+            if (x > 0 && y > 0 && x < 319 && y < 239)
+            {
+                auto p = [&](int i, int j)
+                { return static_cast<int>(gray(x + i, y + j).value); };
+                dx = A * (p(1, -1) - p(-1, -1) + p(1, 1) - p(-1, 1)) + B * (p(1, 0) - p(-1, 0));
+                dy = A * (p(-1, 1) - p(-1, -1) + p(1, 1) - p(1, -1)) + B * (p(0, 1) - p(0, -1));
+            }
+            if (grad.dx(x, y) != dx || grad.dy(x, y) != dy || grad.magnitude(x, y) != std::abs(dx) + std::abs(dy))
+            {
+                std::cerr << "Gradient mismatch at (" << x << ", " << y << ")" << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+
+    dv::image::Image<PixelFormat::RGB565, 320, 240> img_rgb565;
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    delete[] raw_data;
+    auto gray = dv::image::Image<PixelFormat::Grayscale, 320, 240>();
+    dv::image::image_cast(img_rgb565, gray);
+
+    if (!check_gradient<Kernel::Sobel>(gray) || !check_gradient<Kernel::Scharr>(gray))
+        return -1;
+
+    auto time_0 = clock();
+    grad.compute<Kernel::Sobel>(gray);
+    auto time_1 = clock();
+    auto edge_img = dv::image::Image<PixelFormat::Binary, 320, 240>();
+    const uint16_t threshold = 120;
+    dv::gradient::edges(gray, edge_img, threshold);
+    auto time_2 = clock();
+    std::cout << "Gradient " << double(time_1 - time_0) / CLOCKS_PER_SEC << " seconds, NMS edges "
+              << double(time_2 - time_1) / CLOCKS_PER_SEC << " seconds" << std::endl;
+
+    // 用整帧梯度重新做一遍非极大值抑制作为参照
+    size_t count = 0;
+    for (int y = 0; y < 240; ++y)
+    {
+        for (int x = 0; x < 320; ++x)
+        {
+            bool edge = false;
+            if (x > 0 && y > 0 && x < 319 && y < 239 && grad.magnitude(x, y) > threshold)
+            {
+                static const int offsets[4][2] = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}};
+                const int *o = offsets[grad.direction(x, y)];
+                uint16_t m = grad.magnitude(x, y);
+                edge = m > grad.magnitude(x - o[0], y - o[1]) && m >= grad.magnitude(x + o[0], y + o[1]);
+            }
+            if (edge != (static_cast<uint8_t>(edge_img(x, y)) != 0))
+            {
+                std::cerr << "Edge map mismatch at (" << x << ", " << y << ")" << std::endl;
+                return -1;
+            }
+            count += edge;
+        }
+    }
+    std::cout << "Edge pixels: " << count << std::endl;
+
+    // 宽度不是 8 的倍数时按位写入
+    auto odd = dv::image::Image<PixelFormat::Grayscale, 37, 11>();
+    for (size_t y = 0; y < 11; ++y)
+        for (size_t x = 0; x < 37; ++x)
+            odd(x, y).value = gray(x * 5, y * 13).value;
+    auto odd_edges = dv::image::Image<PixelFormat::Binary, 37, 11>();
+    std::memset(odd_edges.get_data_ptr(), 0xFF, odd_edges.get_data_size());
+    dv::gradient::edges(odd, odd_edges, 50);
+    for (size_t x = 0; x < 37; ++x)
+    {
+        if (static_cast<uint8_t>(odd_edges(x, 0)) || static_cast<uint8_t>(odd_edges(x, 10)))
+        {
+            std::cerr << "Border row not cleared" << std::endl;
+            return -1;
+        }
+    }
+    return 0;
+}
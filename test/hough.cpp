@@ -0,0 +1,91 @@
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+#include <dv.hpp>
+#include <time.h>
+
+using dv::pixel_format::PixelFormat;
+using dv::pixel_format::GrayscalePixel;
+
+static dv::hough::CircleHough<320, 240> hough;
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+
+    dv::image::Image<PixelFormat::RGB565, 320, 240> img_rgb565;
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    delete[] raw_data;
+    auto gray = dv::image::Image<PixelFormat::Grayscale, 320, 240>();
+    dv::image::image_cast(img_rgb565, gray);
+
+    hough.set_radius_range(8, 60);
+    auto time_0 = clock();
+    size_t count = hough.detect(gray, dv::image::Rect{0, 0, 320, 240});
+    auto time_1 = clock();
+    std::cout << "img.bin: " << count << " circles, " << hough.edge_count() << " edges in "
+              << double(time_1 - time_0) / CLOCKS_PER_SEC << " seconds" << std::endl;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto &c = hough.circle(i);
+        std::cout << "Circle " << i << ": (" << c.x << ", " << c.y << ") r " << c.r << " votes " << c.votes
+                  << " support " << c.support << std::endl;
+    }
+
+    // 合成场景：一个亮圆和一个同样亮的矩形反光，只应检出圆
+    auto scene = dv::image::Image<PixelFormat::Grayscale, 320, 240>();
+    dv::draw::filled_rect(scene, 0, 0, 319, 239, GrayscalePixel{30});
+    dv::draw::filled_circle(scene, 200, 110, 25, GrayscalePixel{220});
+    dv::draw::filled_rect(scene, 40, 60, 110, 100, GrayscalePixel{220});
+    hough.set_min_votes(100);
+    hough.set_min_distance(20);
+
+    time_0 = clock();
+    count = hough.detect(scene, dv::image::Rect{0, 0, 320, 240});
+    time_1 = clock();
+    std::cout << "Synthetic: " << count << " circles, " << hough.edge_count() << " edges in "
+              << double(time_1 - time_0) / CLOCKS_PER_SEC << " seconds" << std::endl;
+    if (count == 0)
+    {
+        std::cerr << "Circle not found" << std::endl;
+        return -1;
+    }
+    const auto &best = hough.circle(0);
+    std::cout << "Best circle: (" << best.x << ", " << best.y << ") r " << best.r << " votes " << best.votes << std::endl;
+    if (std::abs(best.x - 200) > 1 || std::abs(best.y - 110) > 1 || std::abs(best.r - 25) > 1)
+    {
+        std::cerr << "Circle position mismatch" << std::endl;
+        return -1;
+    }
+    for (size_t i = 1; i < count; ++i)
+    {
+        if (hough.circle(i).votes * 2 > best.votes)
+        {
+            std::cerr << "Rectangle detected as a strong circle" << std::endl;
+            return -1;
+        }
+    }
+
+    // roi 限制：只在矩形附近搜索时不应得到强圆
+    count = hough.detect(scene, dv::image::Rect{20, 40, 130, 120});
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (hough.circle(i).votes * 2 > best.votes)
+        {
+            std::cerr << "Rectangle detected as a strong circle inside ROI" << std::endl;
+            return -1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <iostream>
+#include <cmath>
+
+#include <dv.hpp>
+#include <time.h>
+
+using dv::pixel_format::PixelFormat;
+using dv::image::Image;
+using namespace dv::pixel_format;
+
+// 浮点公式：色相 = 扇区 + diff / delta（以 1/6 圈为单位），换算到 256 级后四舍五入
+static HSVPixel hsv_reference(int r, int g, int b)
+{
+    int max = std::max({r, g, b}), min = std::min({r, g, b});
+    int delta = max - min;
+    if (delta == 0)
+        return HSVPixel{0, 0, static_cast<uint8_t>(max)};
+    double s = std::floor(255.0 * delta / max + 0.5);
+    double sector = max == r ? 0 : (max == g ? 2 : 4);
+    double diff = max == r ? g - b : (max == g ? b - r : r - g);
+    double h = std::floor((sector + 6 + diff / delta) / 6.0 * 256.0 + 0.5);
+    return HSVPixel{static_cast<uint8_t>(static_cast<int>(h) & 0xFF), static_cast<uint8_t>(s), static_cast<uint8_t>(max)};
+}
+
+// 跨过 0 的色相区间用两个分支判断
+static bool wrapped_reference(const HSVPixel &p, const HSVPixel &lo, const HSVPixel &hi)
+{
+    bool hue = lo.h <= hi.h ? (p.h >= lo.h && p.h <= hi.h) : (p.h >= lo.h || p.h <= hi.h);
+    return hue && p.s >= lo.s && p.s <= hi.s && p.v >= lo.v && p.v <= hi.v;
+}
+
+template <size_t W, size_t H>
+static bool check_threshold(const Image<PixelFormat::HSV, W, H> &img, const HSVPixel &lo, const HSVPixel &hi, const char *name)
+{
+    static Image<PixelFormat::Binary, W, H> mask;
+    dv::binaryzation::threshold(img, mask, lo, hi);
+    const auto &result = mask;
+    size_t count = 0;
+    for (size_t y = 0; y < H; ++y)
+    {
+        for (size_t x = 0; x < W; ++x)
+        {
+            bool expected = wrapped_reference(img(x, y), lo, hi);
+            if ((result(x, y).value != 0) != expected)
+            {
+                std::cerr << name << ": threshold mismatch at (" << x << ", " << y << ")" << std::endl;
+                return false;
+            }
+            count += expected;
+        }
+    }
+    std::cout << name << ": " << count << " pixels in range" << std::endl;
+    return count > 0;
+}
+
+static Image<PixelFormat::RGB565, 320, 240> img_rgb565;
+static Image<PixelFormat::HSV, 320, 240> img_hsv;
+static Image<PixelFormat::HSV, 256, 64> wheel;
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    // 整数实现与浮点公式在整个 RGB 立方体上完全一致
+    for (int r = 0; r < 256; ++r)
+    {
+        for (int g = 0; g < 256; ++g)
+        {
+            for (int b = 0; b < 256; ++b)
+            {
+                HSVPixel p = rgb_to_hsv(static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b));
+                HSVPixel ref = hsv_reference(r, g, b);
+                if (p.h != ref.h || p.s != ref.s || p.v != ref.v)
+                {
+                    std::cerr << "rgb_to_hsv(" << r << ", " << g << ", " << b << ") mismatch" << std::endl;
+                    return -1;
+                }
+            }
+        }
+    }
+
+    if (HSVPixel::hue_from_degrees(0) != 0 || HSVPixel::hue_from_degrees(360) != 0 ||
+        HSVPixel::hue_from_degrees(180) != 128 || HSVPixel::hue_from_degrees(-90) != HSVPixel::hue_from_degrees(270))
+    {
+        std::cerr << "hue_from_degrees mismatch" << std::endl;
+        return -1;
+    }
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    dv::image::image_cast(img_rgb565, img_hsv);
+
+    // 每列一个色相，每行一个饱和度
+    for (size_t y = 0; y < 64; ++y)
+        for (size_t x = 0; x < 256; ++x)
+            wheel(x, y) = HSVPixel{static_cast<uint8_t>(x), static_cast<uint8_t>(y * 4), 200};
+
+    const HSVPixel red_lo{HSVPixel::hue_from_degrees(350), 40, 30};
+    const HSVPixel red_hi{HSVPixel::hue_from_degrees(10), 255, 255};
+    const HSVPixel green_lo{HSVPixel::hue_from_degrees(90), 40, 30};
+    const HSVPixel green_hi{HSVPixel::hue_from_degrees(150), 255, 255};
+    if (!check_threshold(wheel, red_lo, red_hi, "Hue wheel 350-10") ||
+        !check_threshold(wheel, green_lo, green_hi, "Hue wheel 90-150") ||
+        !check_threshold(img_hsv, red_lo, red_hi, "Image 350-10") ||
+        !check_threshold(img_hsv, HSVPixel{HSVPixel::hue_from_degrees(300), 0, 0}, HSVPixel{HSVPixel::hue_from_degrees(60), 255, 255}, "Image 300-60"))
+        return -1;
+
+    delete[] raw_data;
+    return 0;
+}
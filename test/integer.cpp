@@ -0,0 +1,155 @@
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+#include <dv.hpp>
+#include <time.h>
+
+using dv::pixel_format::PixelFormat;
+using dv::binaryzation::OTSU_HIST_SIZE;
+
+static const dv::pixel_format::LABPixel committed_lab_table[65536] = {
+#include "dv/rgb565_lab_table.inc"
+};
+
+// 整数实现（DV_INTEGER_ONLY）与浮点实现逐项比较；两种构建下都可以运行
+static bool check_otsu(const char *name, const size_t hist[OTSU_HIST_SIZE], size_t total)
+{
+    uint8_t f = dv::binaryzation::otsu_threshold_float(hist, total);
+    uint8_t i = dv::binaryzation::otsu_threshold_fixed(hist, total);
+    if (f != i)
+    {
+        std::cerr << "Otsu mismatch on " << name << ": float " << static_cast<int>(f) << ", integer "
+                  << static_cast<int>(i) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// round(0.299f * r + 0.587f * g + 0.114f * b) 按单精度、不做 FMA 合并的参考值。
+// 乘积和两个 float 的和在 double 中都是精确的，每步转 float 只舍入一次；
+// 中间都经过 float 转换，-ffp-contract=fast 也无法把它们合并成 fma
+static uint8_t luma_reference(uint8_t r, uint8_t g, uint8_t b)
+{
+    const float pr = static_cast<float>(static_cast<double>(0.299f) * r);
+    const float pg = static_cast<float>(static_cast<double>(0.587f) * g);
+    const float pb = static_cast<float>(static_cast<double>(0.114f) * b);
+    const float sum = static_cast<float>(static_cast<double>(static_cast<float>(static_cast<double>(pr) + pg)) + pb);
+    return static_cast<uint8_t>(std::round(sum));
+}
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+#if defined(DV_INTEGER_ONLY)
+    std::cout << "Integer-only build" << std::endl;
+#endif
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+
+    auto img_rgb565 = dv::image::Image<PixelFormat::RGB565, 320, 240>();
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    delete[] raw_data;
+
+    // 亮度：全部 2^24 种 RGB 组合
+    auto time_0 = clock();
+    for (uint32_t i = 0; i < (1u << 24); ++i)
+    {
+        uint8_t r = static_cast<uint8_t>(i >> 16), g = static_cast<uint8_t>(i >> 8), b = static_cast<uint8_t>(i);
+        if (dv::pixel_format::rgb_to_luma(r, g, b) != luma_reference(r, g, b))
+        {
+            std::cerr << "Luma mismatch at (" << static_cast<int>(r) << ", " << static_cast<int>(g) << ", "
+                      << static_cast<int>(b) << ")" << std::endl;
+            return -1;
+        }
+    }
+    auto time_1 = clock();
+    std::cout << "Luma identical for all RGB values (" << double(time_1 - time_0) / CLOCKS_PER_SEC << " seconds)" << std::endl;
+
+    // LAB 表：整数构建中是随源码提交的生成表。两种构建都直接检查提交的表，
+    // 浮点实现改了而没有重新生成（cmake --build <build> --target lab_table）时在这里失败
+    const auto lab_reference = dv::pixel_format::rgb565_to_lab_lookup_tables_init_();
+    const auto &lab_table = dv::pixel_format::rgb565_to_lab_lookup_table();
+    for (size_t i = 0; i < lab_table.size(); ++i)
+    {
+        const auto &committed = committed_lab_table[i];
+        if (lab_table[i].l != lab_reference[i].l || lab_table[i].a != lab_reference[i].a || lab_table[i].b != lab_reference[i].b)
+        {
+            std::cerr << "LAB table mismatch at " << i << std::endl;
+            return -1;
+        }
+        if (committed.l != lab_reference[i].l || committed.a != lab_reference[i].a || committed.b != lab_reference[i].b)
+        {
+            std::cerr << "include/dv/rgb565_lab_table.inc is stale at " << i << ", regenerate it" << std::endl;
+            return -1;
+        }
+    }
+
+    // Otsu：test/otsu.cpp、test/stream.cpp 的灰度直方图，各颜色通道和 LAB 的 L 通道
+    auto gray = dv::image::Image<PixelFormat::Grayscale, 320, 240>();
+    auto rgb = dv::image::Image<PixelFormat::RGB, 320, 240>();
+    auto lab = dv::image::Image<PixelFormat::LAB, 320, 240>();
+    dv::image::image_cast(img_rgb565, gray);
+    dv::image::image_cast(img_rgb565, rgb);
+    dv::image::image_cast(img_rgb565, lab);
+    size_t hist[5][OTSU_HIST_SIZE] = {};
+    for (size_t y = 0; y < 240; ++y)
+    {
+        for (size_t x = 0; x < 320; ++x)
+        {
+            hist[0][gray(x, y).value]++;
+            hist[1][rgb(x, y).r]++;
+            hist[2][rgb(x, y).g]++;
+            hist[3][rgb(x, y).b]++;
+            hist[4][static_cast<uint8_t>(lab(x, y).l)]++;
+        }
+    }
+    const char *names[5] = {"gray", "red", "green", "blue", "L"};
+    for (int i = 0; i < 5; ++i)
+    {
+        if (!check_otsu(names[i], hist[i], 320 * 240))
+            return -1;
+    }
+    dv::stream::RowHistogram<320> row_hist;
+    row_hist.reset();
+    for (size_t y = 0; y < 240; ++y)
+        row_hist.push_row(&gray(0, y));
+    if (row_hist.otsu() != dv::binaryzation::otsu_threshold_float(hist[0], 320 * 240))
+    {
+        std::cerr << "Streamed otsu mismatch" << std::endl;
+        return -1;
+    }
+
+    // 随机直方图：双峰和稀疏分布
+    std::srand(1);
+    for (int round = 0; round < 2000; ++round)
+    {
+        size_t h[OTSU_HIST_SIZE] = {};
+        size_t total = 0;
+        int peaks[2] = {std::rand() % 256, std::rand() % 256};
+        int width = 1 + std::rand() % 40;
+        for (int n = 0; n < 20000; ++n)
+        {
+            int v = peaks[n & 1] + std::rand() % (2 * width + 1) - width;
+            if (round % 2 && std::rand() % 4)
+                continue;
+            v = v < 0 ? 0 : (v > 255 ? 255 : v);
+            h[v]++;
+            total++;
+        }
+        if (!check_otsu("random histogram", h, total))
+            return -1;
+    }
+
+    std::cout << "Gray otsu threshold " << static_cast<int>(dv::binaryzation::otsu_threshold(hist[0], 320 * 240)) << std::endl;
+    return 0;
+}
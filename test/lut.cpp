@@ -0,0 +1,87 @@
+#include <iostream>
+#include <cstring>
+
+#include <dv.hpp>
+#include <time.h>
+
+// 在测试里对 RGB888 也打开打表，用来对比表和移位运算哪个快
+namespace dv
+{
+    namespace pixel_format
+    {
+        template <>
+        struct Rgb565Lut<RGBPixel> : Rgb565LutFromCast<RGBPixel>
+        {
+        };
+    }
+}
+
+using dv::pixel_format::PixelFormat;
+
+// 逐像素计算，不走查表的 image_cast
+template <PixelFormat PF>
+static double cast_arithmetic(const dv::image::Image<PixelFormat::RGB565, 320, 240> &src,
+                              dv::image::Image<PF, 320, 240> &dst)
+{
+    auto time_0 = clock();
+    for (int k = 0; k < 10; ++k)
+    {
+        for (size_t y = 0; y < 240; ++y)
+            for (size_t x = 0; x < 320; ++x)
+                dv::pixel_format::pixel_cast(src(x, y), dst(x, y));
+    }
+    return double(clock() - time_0) / CLOCKS_PER_SEC;
+}
+
+template <PixelFormat PF>
+static double cast_table(const dv::image::Image<PixelFormat::RGB565, 320, 240> &src,
+                         dv::image::Image<PF, 320, 240> &dst)
+{
+    dv::image::image_cast(src, dst); // 第一次调用生成表，不计时
+    auto time_0 = clock();
+    for (int k = 0; k < 10; ++k)
+        dv::image::image_cast(src, dst);
+    return double(clock() - time_0) / CLOCKS_PER_SEC;
+}
+
+template <PixelFormat PF>
+static bool compare(const char *name, const dv::image::Image<PixelFormat::RGB565, 320, 240> &src)
+{
+    auto arith = dv::image::Image<PF, 320, 240>();
+    auto table = dv::image::Image<PF, 320, 240>();
+    double t_arith = cast_arithmetic(src, arith);
+    double t_table = cast_table(src, table);
+    std::cout << name << ": arithmetic " << t_arith << " seconds, table " << t_table << " seconds (10 frames)" << std::endl;
+    if (std::memcmp(arith.get_data_ptr(), table.get_data_ptr(), arith.get_data_size()) != 0)
+    {
+        std::cerr << name << " table mismatch" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+
+    dv::image::Image<PixelFormat::RGB565, 320, 240> img_rgb565;
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    delete[] raw_data;
+
+    if (!compare<PixelFormat::Grayscale>("Grayscale", img_rgb565) ||
+        !compare<PixelFormat::RGB>("RGB", img_rgb565) ||
+        !compare<PixelFormat::LAB>("LAB", img_rgb565) ||
+        !compare<PixelFormat::HSV>("HSV", img_rgb565))
+        return -1;
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <cstring>
+
+#include <dv.hpp>
+#include <time.h>
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    const size_t width = 320;
+    const size_t height = 240;
+    uint8_t *raw_data = new uint8_t[width * height * 2];
+    fread(raw_data, 1, width * height * 2, file);
+    fclose(file);
+
+    dv::image::Image<dv::pixel_format::PixelFormat::RGB565, 320, 240> img_rgb565;
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    delete[] raw_data;
+    std::cout << "Image loaded: " << img_rgb565.width() << "x" << img_rgb565.height() << std::endl;
+
+    auto lab_img = dv::image::Image<dv::pixel_format::PixelFormat::LAB, 320, 240>();
+    dv::image::image_cast(img_rgb565, lab_img);
+
+    auto bin_img = dv::image::Image<dv::pixel_format::PixelFormat::Binary, 320, 240>();
+    dv::binaryzation::threshold(lab_img, bin_img, dv::pixel_format::LABPixel{30, -128, 0}, dv::pixel_format::LABPixel{100, -20, 127});
+
+    constexpr size_t max_size = dv::codec::mask_max_encoded_size<320, 240>();
+    uint8_t *encoded = new uint8_t[max_size];
+    auto decoded = dv::image::Image<dv::pixel_format::PixelFormat::Binary, 320, 240>();
+    dv::codec::CodecStats stats;
+
+    auto time_0 = clock();
+    for (int i = 0; i < 1000; i++)
+    {
+        size_t size = dv::codec::mask_encode(bin_img, encoded, max_size);
+        stats.record(bin_img.get_data_size(), size);
+    }
+    auto time_1 = clock();
+    double elapsed_secs = double(time_1 - time_0) / CLOCKS_PER_SEC;
+
+    size_t size = dv::codec::mask_encode(bin_img, encoded, max_size);
+    if (!dv::codec::mask_decode(encoded, size, decoded) ||
+        std::memcmp(decoded.get_data_ptr(), bin_img.get_data_ptr(), bin_img.get_data_size()) != 0)
+    {
+        std::cerr << "Round trip mismatch" << std::endl;
+        return -1;
+    }
+    delete[] encoded;
+
+    std::cout << "Encoded mask: " << stats.bytes_per_frame() << " bytes per frame (ratio " << stats.ratio() << ")" << std::endl;
+    std::cout << "Time taken for encoding: " << elapsed_secs / 1000 << " seconds." << std::endl;
+    return 0;
+}
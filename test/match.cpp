@@ -0,0 +1,162 @@
+#include <iostream>
+#include <cstring>
+#include <cmath>
+
+#include <dv.hpp>
+#include <time.h>
+
+using dv::pixel_format::PixelFormat;
+
+static dv::match::TemplateMatcher<320, 240, 24, 24> matcher;
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+
+    dv::image::Image<PixelFormat::RGB565, 320, 240> img_rgb565;
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    delete[] raw_data;
+    auto gray = dv::image::Image<PixelFormat::Grayscale, 320, 240>();
+    dv::image::image_cast(img_rgb565, gray);
+
+    // 以图像中灰度方差最大的 24x24 区域作为模板，匹配结果应回到原位置
+    int tx = 0, ty = 0;
+    double best_var = -1;
+    for (int y = 0; y + 24 <= 240; y += 4)
+    {
+        for (int x = 0; x + 24 <= 320; x += 4)
+        {
+            double s = 0, q = 0;
+            for (int j = 0; j < 24; ++j)
+                for (int i = 0; i < 24; ++i)
+                {
+                    double v = gray(x + i, y + j).value;
+                    s += v;
+                    q += v * v;
+                }
+            double var = q / 576 - (s / 576) * (s / 576);
+            if (var > best_var)
+            {
+                best_var = var;
+                tx = x;
+                ty = y;
+            }
+        }
+    }
+    auto tpl = dv::image::Image<PixelFormat::Grayscale, 24, 24>();
+    for (int j = 0; j < 24; ++j)
+        for (int i = 0; i < 24; ++i)
+            tpl(i, j) = gray(tx + i, ty + j);
+    matcher.set_template(tpl);
+    std::cout << "Template at (" << tx << ", " << ty << ")" << std::endl;
+
+    const dv::image::Rect full{0, 0, 320, 240};
+    const dv::image::Rect roi{tx - 40, ty - 40, tx + 64, ty + 64};
+    dv::match::MatchResult result;
+
+    auto time_0 = clock();
+    if (!matcher.sad(gray, roi, result) || result.x != tx || result.y != ty || result.score != 0)
+    {
+        std::cerr << "SAD match failed" << std::endl;
+        return -1;
+    }
+    auto time_1 = clock();
+    if (!matcher.ncc(gray, roi, result) || result.x != tx || result.y != ty ||
+        std::fabs(double(result.score) / dv::match::NCC_ONE - 1.0) > 1e-4)
+    {
+        std::cerr << "NCC match failed" << std::endl;
+        return -1;
+    }
+    auto time_2 = clock();
+    if (!matcher.sad_coarse_to_fine(gray, full, result) || result.x != tx || result.y != ty)
+    {
+        std::cerr << "Coarse-to-fine SAD match failed" << std::endl;
+        return -1;
+    }
+    auto time_3 = clock();
+    if (!matcher.ncc_coarse_to_fine(gray, full, result) || result.x != tx || result.y != ty)
+    {
+        std::cerr << "Coarse-to-fine NCC match failed" << std::endl;
+        return -1;
+    }
+    auto time_4 = clock();
+    std::cout << "ROI SAD " << double(time_1 - time_0) / CLOCKS_PER_SEC << " s, ROI NCC "
+              << double(time_2 - time_1) / CLOCKS_PER_SEC << " s, full-frame coarse-to-fine SAD "
+              << double(time_3 - time_2) / CLOCKS_PER_SEC << " s, NCC " << double(time_4 - time_3) / CLOCKS_PER_SEC
+              << " s" << std::endl;
+
+    // NCC 与逐像素浮点计算对比
+    const int cx = tx + 3, cy = ty - 2;
+    double s = 0, q = 0, st = 0, qt = 0, d = 0;
+    for (int j = 0; j < 24; ++j)
+        for (int i = 0; i < 24; ++i)
+        {
+            double v = gray(cx + i, cy + j).value, t = tpl(i, j).value;
+            s += v;
+            q += v * v;
+            st += t;
+            qt += t * t;
+            d += v * t;
+        }
+    double expected = (576 * d - s * st) / std::sqrt((576 * q - s * s) * (576 * qt - st * st));
+    if (!matcher.ncc(gray, dv::image::Rect{cx, cy, cx + 24, cy + 24}, result) ||
+        std::fabs(double(result.score) / dv::match::NCC_ONE - expected) > 1e-4)
+    {
+        std::cerr << "NCC score mismatch: " << result.score << " vs " << expected << std::endl;
+        return -1;
+    }
+
+    // 候选比较是精确的整数交叉相乘：最优位置与逐候选的双精度计算相同
+    const dv::image::Rect search{tx - 30, ty - 30, tx + 50, ty + 50};
+    const int probe_x = tx + 17, probe_y = ty + 11;
+    auto probe_tpl = dv::image::Image<PixelFormat::Grayscale, 24, 24>();
+    for (int j = 0; j < 24; ++j)
+        for (int i = 0; i < 24; ++i)
+            probe_tpl(i, j) = gray(probe_x + i, probe_y + j) / 2 + (i * j) % 7;
+    matcher.set_template(probe_tpl);
+    double best = -2;
+    int best_x = 0, best_y = 0;
+    for (int y = search.y0; y + 24 <= search.y1; ++y)
+    {
+        for (int x = search.x0; x + 24 <= search.x1; ++x)
+        {
+            double s = 0, q = 0, st = 0, qt = 0, d = 0;
+            for (int j = 0; j < 24; ++j)
+                for (int i = 0; i < 24; ++i)
+                {
+                    double v = gray(x + i, y + j).value, t = probe_tpl(i, j).value;
+                    s += v;
+                    q += v * v;
+                    st += t;
+                    qt += t * t;
+                    d += v * t;
+                }
+            double var = (576 * q - s * s) * (576 * qt - st * st);
+            double score = var > 0 ? (576 * d - s * st) / std::sqrt(var) : 0;
+            if (score > best)
+            {
+                best = score;
+                best_x = x;
+                best_y = y;
+            }
+        }
+    }
+    if (!matcher.ncc(gray, search, result) || result.x != best_x || result.y != best_y ||
+        std::fabs(double(result.score) / dv::match::NCC_ONE - best) > 1e-4)
+    {
+        std::cerr << "NCC best candidate mismatch: (" << result.x << ", " << result.y << ") vs (" << best_x << ", "
+                  << best_y << ")" << std::endl;
+        return -1;
+    }
+    return 0;
+}
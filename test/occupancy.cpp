@@ -0,0 +1,249 @@
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+#include <dv.hpp>
+#include <time.h>
+
+using dv::pixel_format::PixelFormat;
+using dv::image::Image;
+
+// 占用位与逐像素扫描的结果比较
+template <size_t W, size_t H>
+static bool check_map(const Image<PixelFormat::Binary, W, H> &img, const dv::binaryzation::OccupancyMap<W, H> &occ)
+{
+    size_t count = 0;
+    for (size_t ty = 0; ty < occ.TILES_Y; ++ty)
+    {
+        bool row_any = false;
+        for (size_t tx = 0; tx < occ.TILES_X; ++tx)
+        {
+            bool any = false;
+            for (size_t y = ty * 8; y < ty * 8 + 8 && y < H; ++y)
+                for (size_t x = tx * 8; x < tx * 8 + 8 && x < W; ++x)
+                    any |= img(x, y).value != 0;
+            if (any != occ.occupied(tx, ty))
+            {
+                std::cerr << "Tile (" << tx << ", " << ty << ") occupancy mismatch" << std::endl;
+                return false;
+            }
+            row_any |= any;
+            count += any;
+        }
+        if (row_any != occ.row_occupied(ty))
+        {
+            std::cerr << "Tile row " << ty << " occupancy mismatch" << std::endl;
+            return false;
+        }
+    }
+    size_t visited = 0;
+    occ.for_each_tile([&](size_t tx, size_t ty)
+                      { visited += occ.occupied(tx, ty); });
+    if (count != occ.count() || count != visited)
+    {
+        std::cerr << "Occupied tile count mismatch" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template <typename A, typename B>
+static bool same_blobs(const A &a, const B &b)
+{
+    if (a.blob_count() != b.blob_count())
+        return false;
+    for (size_t i = 0; i < a.blob_count(); ++i)
+    {
+        const auto &x = a.blob(i), &y = b.blob(i);
+        if (x.area != y.area || x.x0 != y.x0 || x.y0 != y.y0 || x.x1 != y.x1 || x.y1 != y.y1 ||
+            x.sum_x != y.sum_x || x.sum_y != y.sum_y)
+            return false;
+    }
+    return true;
+}
+
+static dv::stream::RunExtractor<320> full_runs;
+static dv::stream::RunExtractor<320> tiled_runs;
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+
+    auto img_rgb565 = Image<PixelFormat::RGB565, 320, 240>();
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    auto lab_img = Image<PixelFormat::LAB, 320, 240>();
+    dv::image::image_cast(img_rgb565, lab_img);
+    auto gray = Image<PixelFormat::Grayscale, 320, 240>();
+    dv::image::image_cast(img_rgb565, gray);
+
+    // 与 test/stream.cpp 相同的绿色阈值，掩码绝大部分为空
+    const dv::pixel_format::LABPixel t_low{30, -128, 0};
+    const dv::pixel_format::LABPixel t_high{100, -20, 127};
+    auto mask = Image<PixelFormat::Binary, 320, 240>();
+    dv::binaryzation::OccupancyMap<320, 240> occ;
+    dv::binaryzation::threshold(lab_img, mask, t_low, t_high, occ);
+    if (!check_map(mask, occ))
+        return -1;
+    std::cout << "Occupied tiles " << occ.count() << " / " << occ.TILES_X * occ.TILES_Y << std::endl;
+
+    // 逐行生成占用图时写出的掩码与整帧 threshold 完全相同（LAB 逐像素路径、RGB565 整字路径）
+    auto plain = Image<PixelFormat::Binary, 320, 240>();
+    dv::binaryzation::threshold(lab_img, plain, t_low, t_high);
+    if (std::memcmp(plain.get_data_ptr(), mask.get_data_ptr(), mask.get_data_size()) != 0)
+    {
+        std::cerr << "Fused LAB threshold mask mismatch" << std::endl;
+        return -1;
+    }
+    const dv::pixel_format::RGB565Pixel c_low{4, 20, 2}, c_high{20, 63, 16};
+    auto rgb_mask = Image<PixelFormat::Binary, 320, 240>();
+    dv::binaryzation::OccupancyMap<320, 240> rgb_occ;
+    dv::binaryzation::threshold(img_rgb565, plain, c_low, c_high);
+    dv::binaryzation::threshold(img_rgb565, rgb_mask, c_low, c_high, rgb_occ);
+    if (std::memcmp(plain.get_data_ptr(), rgb_mask.get_data_ptr(), rgb_mask.get_data_size()) != 0 ||
+        !check_map(rgb_mask, rgb_occ))
+    {
+        std::cerr << "Fused RGB565 threshold mismatch" << std::endl;
+        return -1;
+    }
+
+    // 计时：阈值化后整帧再扫一遍与逐行顺带标记
+    const int fuse_rounds = 200;
+    auto fuse_0 = clock();
+    for (int i = 0; i < fuse_rounds; ++i)
+    {
+        dv::binaryzation::threshold(img_rgb565, plain, c_low, c_high);
+        rgb_occ.build(plain);
+    }
+    auto fuse_1 = clock();
+    for (int i = 0; i < fuse_rounds; ++i)
+        dv::binaryzation::threshold(img_rgb565, rgb_mask, c_low, c_high, rgb_occ);
+    auto fuse_2 = clock();
+    std::cout << "RGB565 threshold + occupancy: second pass " << double(fuse_1 - fuse_0) / CLOCKS_PER_SEC / fuse_rounds
+              << " seconds, per row " << double(fuse_2 - fuse_1) / CLOCKS_PER_SEC / fuse_rounds << " seconds" << std::endl;
+
+    // 流式处理时逐行标记，结果与整帧生成相同
+    dv::binaryzation::OccupancyMap<320, 240> streamed;
+    streamed.clear();
+    uint8_t bits[dv::stream::row_bytes<320>()];
+    for (size_t y = 0; y < 240; ++y)
+    {
+        dv::stream::threshold_row<320>(&lab_img(0, y), bits, t_low, t_high);
+        streamed.mark_row(y, bits);
+    }
+    for (size_t ty = 0; ty < occ.TILES_Y; ++ty)
+    {
+        if (std::memcmp(occ.tile_row(ty), streamed.tile_row(ty), sizeof(uint64_t) * occ.WORDS) != 0)
+        {
+            std::cerr << "Streamed occupancy mismatch" << std::endl;
+            return -1;
+        }
+    }
+
+    // 只遍历非空块的连通域与逐行全部扫描的结果相同
+    tiled_runs.extract(mask, occ);
+    full_runs.reset();
+    for (size_t y = 0; y < 240; ++y)
+        full_runs.push_row(y, static_cast<const uint8_t *>(mask.get_data_ptr()) + y * 40);
+    full_runs.finish();
+    if (!same_blobs(full_runs, tiled_runs))
+    {
+        std::cerr << "Blob mismatch between full and tiled extraction" << std::endl;
+        return -1;
+    }
+
+    // 计时用稀疏掩码：几个 6x6 的光点，99% 以上为空
+    std::memset(mask.get_data_ptr(), 0, mask.get_data_size());
+    const size_t spots[5][2] = {{17, 30}, {100, 42}, {203, 120}, {260, 200}, {300, 7}};
+    for (const auto &spot : spots)
+        for (size_t y = spot[1]; y < spot[1] + 6; ++y)
+            for (size_t x = spot[0]; x < spot[0] + 6; ++x)
+                mask(x, y) = dv::pixel_format::BinaryPixel{255};
+    occ.build(mask);
+    const int rounds = 100;
+    auto time_0 = clock();
+    for (int i = 0; i < rounds; ++i)
+    {
+        full_runs.reset();
+        for (size_t y = 0; y < 240; ++y)
+            full_runs.push_row(y, static_cast<const uint8_t *>(mask.get_data_ptr()) + y * 40);
+        full_runs.finish();
+    }
+    auto time_1 = clock();
+    for (int i = 0; i < rounds; ++i)
+        tiled_runs.extract(mask, occ);
+    auto time_2 = clock();
+    if (!same_blobs(full_runs, tiled_runs))
+    {
+        std::cerr << "Blob mismatch on sparse mask" << std::endl;
+        return -1;
+    }
+    std::cout << "Sparse mask: " << occ.count() << " occupied tiles, blobs " << tiled_runs.blob_count() << ", full scan " << double(time_1 - time_0) / CLOCKS_PER_SEC / rounds
+              << " seconds, occupied tiles only " << double(time_2 - time_1) / CLOCKS_PER_SEC / rounds << " seconds" << std::endl;
+
+    // Otsu 掩码（大部分非空）
+    auto otsu_mask = Image<PixelFormat::Binary, 320, 240>();
+    dv::binaryzation::otsu(gray, otsu_mask, occ);
+    if (!check_map(otsu_mask, occ))
+        return -1;
+    full_runs.reset();
+    for (size_t y = 0; y < 240; ++y)
+        full_runs.push_row(y, static_cast<const uint8_t *>(otsu_mask.get_data_ptr()) + y * 40);
+    full_runs.finish();
+    tiled_runs.extract(otsu_mask, occ);
+    if (!same_blobs(full_runs, tiled_runs))
+    {
+        std::cerr << "Blob mismatch on otsu mask" << std::endl;
+        return -1;
+    }
+
+    // 宽度不是 8 的倍数，行不从字节边界开始
+    static Image<PixelFormat::Binary, 37, 21> odd;
+    static dv::binaryzation::OccupancyMap<37, 21> odd_occ;
+    static dv::stream::RunExtractor<37> odd_full;
+    static dv::stream::RunExtractor<37> odd_tiled;
+    for (size_t y = 0; y < 21; ++y)
+        for (size_t x = 0; x < 37; ++x)
+            odd(x, y) = dv::pixel_format::BinaryPixel{static_cast<uint8_t>(std::rand() % 9 == 0 ? 255 : 0)};
+    odd_occ.build(odd);
+    if (!check_map(odd, odd_occ))
+        return -1;
+    // 奇数宽度的 Otsu：行缓冲拼回掩码
+    static Image<PixelFormat::Grayscale, 37, 21> odd_gray;
+    static Image<PixelFormat::Binary, 37, 21> odd_plain, odd_fused;
+    static dv::binaryzation::OccupancyMap<37, 21> fused_occ;
+    for (size_t y = 0; y < 21; ++y)
+        for (size_t x = 0; x < 37; ++x)
+            odd_gray(x, y) = dv::pixel_format::GrayscalePixel{static_cast<uint8_t>(std::rand())};
+    dv::binaryzation::otsu(odd_gray, odd_plain);
+    dv::binaryzation::otsu(odd_gray, odd_fused, fused_occ);
+    if (std::memcmp(odd_plain.get_data_ptr(), odd_fused.get_data_ptr(), odd_fused.get_data_size()) != 0 ||
+        !check_map(odd_fused, fused_occ))
+    {
+        std::cerr << "Fused odd-width otsu mismatch" << std::endl;
+        return -1;
+    }
+    uint8_t odd_bits[dv::stream::row_bytes<37>()];
+    odd_full.reset();
+    for (size_t y = 0; y < 21; ++y)
+        odd_full.push_row(y, dv::binaryzation::row_bits(odd, y, odd_bits));
+    odd_full.finish();
+    odd_tiled.extract(odd, odd_occ);
+    if (!same_blobs(odd_full, odd_tiled))
+    {
+        std::cerr << "Blob mismatch on odd-width mask" << std::endl;
+        return -1;
+    }
+
+    delete[] raw_data;
+    return 0;
+}
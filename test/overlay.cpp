@@ -0,0 +1,203 @@
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+#include <dv.hpp>
+#include <time.h>
+
+using dv::pixel_format::PixelFormat;
+using dv::pixel_format::RGB565Pixel;
+using dv::image::Image;
+
+using Overlay = dv::overlay::Overlay<PixelFormat::RGB565, 320, 240>;
+// span 池很小，覆盖整理和直接绘制的回退路径
+using SmallOverlay = dv::overlay::Overlay<PixelFormat::RGB565, 320, 240, 32, 32, 4, 256>;
+
+static Image<PixelFormat::RGB565, 320, 240> base;
+static Image<PixelFormat::RGB565, 320, 240> composited;
+static Image<PixelFormat::RGB565, 320, 240> rendered;
+// 跨帧保留的输出缓冲，只由 composite_dirty() 更新
+static Image<PixelFormat::RGB565, 320, 240> persistent;
+static size_t frame_dirty = 0;
+static Overlay overlay;
+static SmallOverlay small_overlay;
+
+static int rand_range(int lo, int hi)
+{
+    return lo + std::rand() % (hi - lo + 1);
+}
+
+static RGB565Pixel rand_color()
+{
+    RGB565Pixel c;
+    c.r = static_cast<uint8_t>(std::rand());
+    c.g = static_cast<uint8_t>(std::rand());
+    c.b = static_cast<uint8_t>(std::rand());
+    return c;
+}
+
+// 坐标允许超出图像边界，覆盖裁剪路径
+template <typename O>
+static int add_random(O &overlay)
+{
+    int x = rand_range(-40, 340), y = rand_range(-40, 260);
+    switch (std::rand() % 7)
+    {
+    case 0:
+        return overlay.point(x, y, rand_color());
+    case 1:
+        return overlay.line(x, y, rand_range(-40, 340), rand_range(-40, 260), rand_color());
+    case 2:
+        return overlay.rect(x, y, x + rand_range(-30, 60), y + rand_range(-30, 60), rand_color());
+    case 3:
+        return overlay.filled_rect(x, y, x + rand_range(-30, 60), y + rand_range(-30, 60), rand_color());
+    case 4:
+        return overlay.circle(x, y, rand_range(0, 40), rand_color());
+    case 5:
+        return overlay.filled_circle(x, y, rand_range(0, 30), rand_color());
+    default:
+        return overlay.text(x, y, "HUD\n0.00", rand_color(), rand_range(1, 5));
+    }
+}
+
+// composite() 和只重画脏矩形的 composite_dirty() 的结果都必须与在原图副本上直接 render() 完全相同
+template <typename O>
+static bool check(O &overlay, int frame)
+{
+    overlay.composite_dirty(persistent, base);
+    frame_dirty = overlay.dirty_count();
+    std::memcpy(composited.get_data_ptr(), base.get_data_ptr(), base.get_data_size());
+    overlay.composite(composited);
+    std::memcpy(rendered.get_data_ptr(), base.get_data_ptr(), base.get_data_size());
+    overlay.render(rendered);
+    if (std::memcmp(composited.get_data_ptr(), rendered.get_data_ptr(), base.get_data_size()) != 0)
+    {
+        std::cerr << "Composite differs from render at frame " << frame << std::endl;
+        return false;
+    }
+    if (std::memcmp(persistent.get_data_ptr(), rendered.get_data_ptr(), base.get_data_size()) != 0)
+    {
+        std::cerr << "Dirty composite differs from render at frame " << frame << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 随机增删、移动、隐藏、改文字，逐帧比较
+template <typename O>
+static bool random_frames(O &overlay)
+{
+    std::srand(1);
+    std::memcpy(persistent.get_data_ptr(), base.get_data_ptr(), base.get_data_size());
+    int handles[24];
+    for (auto &h : handles)
+        h = add_random(overlay);
+    int fps = overlay.text(4, 4, "FPS 0", RGB565Pixel{}, 2);
+    if (!check(overlay, 0))
+        return false;
+
+    char buf[16];
+    size_t dirty_frames = 0;
+    for (int frame = 1; frame <= 2000; ++frame)
+    {
+        std::snprintf(buf, sizeof(buf), "FPS %d", frame % 7 == 0 ? frame : frame - frame % 7);
+        overlay.set_text(fps, buf);
+        int ops = rand_range(0, 3);
+        for (int i = 0; i < ops; ++i)
+        {
+            int &h = handles[std::rand() % 24];
+            switch (std::rand() % 6)
+            {
+            case 0:
+                overlay.set_position(h, rand_range(-40, 340), rand_range(-40, 260));
+                break;
+            case 1:
+                overlay.set_visible(h, std::rand() % 2);
+                break;
+            case 2:
+                overlay.set_color(h, rand_color());
+                break;
+            case 3:
+                overlay.set_text(h, std::rand() % 2 ? "A\nBC" : "xyz 123");
+                break;
+            case 4:
+                overlay.remove(h);
+                h = add_random(overlay);
+                break;
+            default:
+                overlay.remove(h);
+                break;
+            }
+        }
+        if (!check(overlay, frame))
+            return false;
+        dirty_frames += frame_dirty != 0;
+    }
+
+    // 没有变化的帧不产生脏区域
+    overlay.update();
+    std::memcpy(composited.get_data_ptr(), base.get_data_ptr(), base.get_data_size());
+    overlay.composite(composited);
+    if (overlay.dirty_count() != 0)
+    {
+        std::cerr << "Unchanged frame produced dirty regions" << std::endl;
+        return false;
+    }
+
+    std::cout << dirty_frames << " of 2000 random frames dirty, " << overlay.span_count() << " spans in use" << std::endl;
+    overlay.clear();
+    return check(overlay, -1);
+}
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+    dv::image::raw_to_rgb565(raw_data, base);
+
+    if (!random_frames(overlay) || !random_frames(small_overlay))
+        return -1;
+
+    // 计时：静态 HUD 每帧合成与直接重画
+    for (int i = 0; i < 8; ++i)
+        overlay.text(8, 20 + i * 24, "ABCDEFGHIJ 0123456789", RGB565Pixel{}, 2);
+    overlay.rect(2, 2, 317, 237, RGB565Pixel{});
+    int fps = overlay.text(8, 4, "FPS 0", RGB565Pixel{}, 2);
+    overlay.update();
+    const int rounds = 1000;
+    auto time_0 = clock();
+    for (int i = 0; i < rounds; ++i)
+        overlay.composite(composited);
+    auto time_1 = clock();
+    for (int i = 0; i < rounds; ++i)
+        overlay.render(rendered);
+    auto time_2 = clock();
+    // 只有 FPS 文字每帧变化，其余命令被跳过
+    overlay.composite_dirty(persistent, base);
+    char buf[16];
+    auto time_3 = clock();
+    for (int i = 0; i < rounds; ++i)
+    {
+        std::snprintf(buf, sizeof(buf), "FPS %d", i);
+        overlay.set_text(fps, buf);
+        overlay.composite_dirty(persistent, base);
+    }
+    auto time_4 = clock();
+    std::cout << "Static HUD: composite "
+              << double(time_1 - time_0) / CLOCKS_PER_SEC / rounds << " seconds, render "
+              << double(time_2 - time_1) / CLOCKS_PER_SEC / rounds << " seconds, dirty composite "
+              << double(time_4 - time_3) / CLOCKS_PER_SEC / rounds << " seconds" << std::endl;
+
+    delete[] raw_data;
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <iostream>
+#include <cstring>
+
+#include <dv.hpp>
+#include <time.h>
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    const size_t width = 320;
+    const size_t height = 240;
+    uint8_t *raw_data = new uint8_t[width * height * 2];
+    fread(raw_data, 1, width * height * 2, file);
+    fclose(file);
+
+    dv::image::Image<dv::pixel_format::PixelFormat::RGB565, 320, 240> img_rgb565;
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    delete[] raw_data;
+    std::cout << "Image loaded: " << img_rgb565.width() << "x" << img_rgb565.height() << std::endl;
+
+    using namespace dv::pipeline;
+    using dv::pixel_format::PixelFormat;
+    using dv::pixel_format::GrayscalePixel;
+
+    // 逐步执行：每一步都写出完整的中间图像
+    auto gray = dv::image::Image<PixelFormat::Grayscale, 320, 240>();
+    auto small = dv::image::Image<PixelFormat::Grayscale, 160, 120>();
+    auto bin_step = dv::image::Image<PixelFormat::Binary, 160, 120>();
+    // 先建好 RGB565 -> 灰度表，两种执行方式都不计入建表时间
+    dv::image::image_cast(img_rgb565, gray);
+    auto time_0 = clock();
+    for (int i = 0; i < 100; i++)
+    {
+        dv::image::image_cast(img_rgb565, gray);
+        dv::interpolation::nearest_neighbor(gray, small);
+        dv::binaryzation::threshold(small, bin_step, GrayscalePixel{100}, GrayscalePixel{200});
+    }
+    auto time_1 = clock();
+
+    // 融合执行：只写出最终的二值图
+    auto bin_fused = dv::image::Image<PixelFormat::Binary, 160, 120>();
+    auto fused = img_rgb565 | to<PixelFormat::Grayscale>() | resize<160, 120>() | in_range(GrayscalePixel{100}, GrayscalePixel{200});
+    for (int i = 0; i < 100; i++)
+    {
+        materialize(fused, bin_fused);
+    }
+    auto time_2 = clock();
+
+    if (std::memcmp(bin_step.get_data_ptr(), bin_fused.get_data_ptr(), bin_fused.get_data_size()) != 0)
+    {
+        std::cerr << "Fused result mismatch" << std::endl;
+        return -1;
+    }
+
+    std::cout << "Time taken step by step: " << double(time_1 - time_0) / CLOCKS_PER_SEC / 100 << " seconds." << std::endl;
+    std::cout << "Time taken fused: " << double(time_2 - time_1) / CLOCKS_PER_SEC / 100 << " seconds." << std::endl;
+    return 0;
+}
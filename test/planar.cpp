@@ -0,0 +1,149 @@
+#include <iostream>
+#include <cstring>
+
+#include <dv.hpp>
+#include <time.h>
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+
+    using dv::pixel_format::PixelFormat;
+    using dv::pixel_format::LABPixel;
+    using dv::pixel_format::HSVPixel;
+
+    dv::image::Image<PixelFormat::RGB565, 320, 240> img_rgb565;
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    delete[] raw_data;
+
+    // 交错与平面存储的阈值化结果必须逐位相同
+    auto lab_img = dv::image::Image<PixelFormat::LAB, 320, 240>();
+    auto lab_planar = dv::image::PlanarImage<PixelFormat::LAB, 320, 240>();
+    dv::image::image_cast(img_rgb565, lab_img);
+    dv::image::image_cast(img_rgb565, lab_planar);
+
+    const LABPixel t_low{30, -128, 0};
+    const LABPixel t_high{100, -20, 127};
+    auto bin_img = dv::image::Image<PixelFormat::Binary, 320, 240>();
+    auto bin_planar = dv::image::Image<PixelFormat::Binary, 320, 240>();
+
+    auto time_0 = clock();
+    dv::binaryzation::threshold(lab_img, bin_img, t_low, t_high);
+    auto time_1 = clock();
+    dv::binaryzation::threshold(lab_planar, bin_planar, t_low, t_high);
+    auto time_2 = clock();
+    std::cout << "Interleaved threshold " << double(time_1 - time_0) / CLOCKS_PER_SEC << " seconds, planar "
+              << double(time_2 - time_1) / CLOCKS_PER_SEC << " seconds" << std::endl;
+    if (std::memcmp(bin_img.get_data_ptr(), bin_planar.get_data_ptr(), bin_img.get_data_size()) != 0)
+    {
+        std::cerr << "Planar LAB threshold mismatch" << std::endl;
+        return -1;
+    }
+
+    // 色相跨 0 的环形区间
+    auto hsv_img = dv::image::Image<PixelFormat::HSV, 320, 240>();
+    auto hsv_planar = dv::image::PlanarImage<PixelFormat::HSV, 320, 240>();
+    dv::image::image_cast(img_rgb565, hsv_img);
+    dv::image::image_cast(hsv_img, hsv_planar);
+    const HSVPixel h_low{240, 40, 40};
+    const HSVPixel h_high{20, 255, 255};
+    dv::binaryzation::threshold(hsv_img, bin_img, h_low, h_high);
+    dv::binaryzation::threshold(hsv_planar, bin_planar, h_low, h_high);
+    if (std::memcmp(bin_img.get_data_ptr(), bin_planar.get_data_ptr(), bin_img.get_data_size()) != 0)
+    {
+        std::cerr << "Planar HSV threshold mismatch" << std::endl;
+        return -1;
+    }
+
+    // 平面 -> 交错往返，以及平面 RGB -> 灰度
+    auto rgb_img = dv::image::Image<PixelFormat::RGB, 320, 240>();
+    auto rgb_back = dv::image::Image<PixelFormat::RGB, 320, 240>();
+    auto rgb_planar = dv::image::PlanarImage<PixelFormat::RGB, 320, 240>();
+    dv::image::image_cast(img_rgb565, rgb_img);
+    dv::image::image_cast(rgb_img, rgb_planar);
+    dv::image::image_cast(rgb_planar, rgb_back);
+    if (std::memcmp(rgb_img.get_data_ptr(), rgb_back.get_data_ptr(), rgb_img.get_data_size()) != 0)
+    {
+        std::cerr << "Planar round trip mismatch" << std::endl;
+        return -1;
+    }
+
+    auto gray_img = dv::image::Image<PixelFormat::Grayscale, 320, 240>();
+    auto gray_planar = dv::image::Image<PixelFormat::Grayscale, 320, 240>();
+    dv::image::image_cast(rgb_img, gray_img);
+    dv::image::image_cast(rgb_planar, gray_planar);
+    if (std::memcmp(gray_img.get_data_ptr(), gray_planar.get_data_ptr(), gray_img.get_data_size()) != 0)
+    {
+        std::cerr << "Planar grayscale mismatch" << std::endl;
+        return -1;
+    }
+
+    // 尺寸不是 16 的倍数时的 SIMD 尾部
+    auto odd_img = dv::image::Image<PixelFormat::RGB, 37, 21>();
+    auto odd_back = dv::image::Image<PixelFormat::RGB, 37, 21>();
+    auto odd_planar = dv::image::PlanarImage<PixelFormat::RGB, 37, 21>();
+    auto *odd_bytes = static_cast<uint8_t *>(odd_img.get_data_ptr());
+    for (size_t i = 0; i < odd_img.get_data_size(); ++i)
+        odd_bytes[i] = static_cast<uint8_t>(i * 7 + 3);
+    dv::image::image_cast(odd_img, odd_planar);
+    for (size_t i = 0; i < 37 * 21; ++i)
+    {
+        if (odd_planar.plane(0)[i] != odd_bytes[3 * i] || odd_planar.plane(1)[i] != odd_bytes[3 * i + 1] ||
+            odd_planar.plane(2)[i] != odd_bytes[3 * i + 2])
+        {
+            std::cerr << "Planar split mismatch at " << i << std::endl;
+            return -1;
+        }
+    }
+    dv::image::image_cast(odd_planar, odd_back);
+    if (std::memcmp(odd_img.get_data_ptr(), odd_back.get_data_ptr(), odd_img.get_data_size()) != 0)
+    {
+        std::cerr << "Odd-size planar round trip mismatch" << std::endl;
+        return -1;
+    }
+
+    // 定点 SIMD 亮度对全部 2^24 种 RGB 与 rgb_to_luma 逐位一致
+    static uint8_t r_plane[65536], g_plane[65536], b_plane[65536], luma[65536];
+    for (size_t i = 0; i < 65536; ++i)
+    {
+        g_plane[i] = static_cast<uint8_t>(i >> 8);
+        b_plane[i] = static_cast<uint8_t>(i);
+    }
+    for (int r = 0; r < 256; ++r)
+    {
+        std::memset(r_plane, r, sizeof(r_plane));
+        dv::image::planar_luma_(r_plane, g_plane, b_plane, luma, 65536);
+        for (size_t i = 0; i < 65536; ++i)
+        {
+            if (luma[i] != dv::pixel_format::rgb_to_luma(r_plane[i], g_plane[i], b_plane[i]))
+            {
+                std::cerr << "Planar luma mismatch at (" << r << ", " << i / 256 << ", " << i % 256 << ")"
+                          << std::endl;
+                return -1;
+            }
+        }
+    }
+
+    const int runs = 200;
+    time_0 = clock();
+    for (int k = 0; k < runs; ++k)
+        dv::image::image_cast(rgb_img, rgb_planar);
+    time_1 = clock();
+    for (int k = 0; k < runs; ++k)
+        dv::image::image_cast(rgb_planar, gray_planar);
+    time_2 = clock();
+    std::cout << "Deinterleave " << double(time_1 - time_0) / CLOCKS_PER_SEC / runs << " seconds, planar luma "
+              << double(time_2 - time_1) / CLOCKS_PER_SEC / runs << " seconds" << std::endl;
+    std::cout << "Planar results match interleaved" << std::endl;
+    return 0;
+}
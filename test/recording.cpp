@@ -0,0 +1,104 @@
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <dv.hpp>
+#include <dv/recording.hpp>
+#include <time.h>
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    const size_t width = 320;
+    const size_t height = 240;
+    uint8_t *raw_data = new uint8_t[width * height * 2];
+    fread(raw_data, 1, width * height * 2, file);
+    fclose(file);
+
+    dv::image::Image<dv::pixel_format::PixelFormat::RGB565, 320, 240> img_rgb565;
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    delete[] raw_data;
+    std::cout << "Image loaded: " << img_rgb565.width() << "x" << img_rgb565.height() << std::endl;
+
+    const size_t frames = 32;
+    dv::recording::RecordingWriter writer;
+    if (!writer.open<dv::pixel_format::PixelFormat::RGB565, 320, 240>("rec.dvr"))
+    {
+        std::cerr << "Failed to open rec.dvr for writing" << std::endl;
+        return -1;
+    }
+    for (size_t i = 0; i < frames; ++i)
+    {
+        writer.write(img_rgb565, i * 33333);
+    }
+    writer.close();
+    std::cout << "Recorded " << frames << " frames" << std::endl;
+
+    dv::recording::RecordingReader reader;
+    if (!reader.open("rec.dvr"))
+    {
+        std::cerr << "Failed to open rec.dvr" << std::endl;
+        return -1;
+    }
+
+    auto gray = dv::image::Image<dv::pixel_format::PixelFormat::Grayscale, 320, 240>();
+    auto time_0 = clock();
+    for (size_t i = 0; i < reader.frame_count(); ++i)
+    {
+        dv::image::ImageView<dv::pixel_format::PixelFormat::RGB565, 320, 240> view;
+        if (!reader.frame(i, view) ||
+            std::memcmp(view.get_data_ptr(), img_rgb565.get_data_ptr(), view.get_data_size()) != 0)
+        {
+            std::cerr << "Frame " << i << " mismatch" << std::endl;
+            return -1;
+        }
+        reader.prefetch(i + 1);
+        dv::image::image_cast(view, gray);
+    }
+    auto time_1 = clock();
+    double elapsed_secs = double(time_1 - time_0) / CLOCKS_PER_SEC;
+
+    std::cout << "Replayed " << reader.frame_count() << " frames, last timestamp "
+              << reader.timestamp(reader.frame_count() - 1) << " us" << std::endl;
+    std::cout << "Time per frame: " << elapsed_secs / reader.frame_count() << " seconds." << std::endl;
+    reader.close();
+
+    // 帧偏移指向文件头的录像必须被拒绝
+    file = fopen("rec.dvr", "rb");
+    std::vector<uint8_t> bytes(sizeof(dv::recording::FileHeader));
+    fread(bytes.data(), 1, bytes.size(), file);
+    dv::recording::FileHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    fseek(file, 0, SEEK_END);
+    bytes.resize(static_cast<size_t>(ftell(file)));
+    fseek(file, 0, SEEK_SET);
+    fread(bytes.data(), 1, bytes.size(), file);
+    fclose(file);
+    // 最后一个是对齐的、加上 frame_bytes 后回绕到文件内的偏移
+    const uint64_t bad_offsets[] = {0, dv::recording::FRAME_ALIGN / 2, header.index_offset,
+                                    (~uint64_t(0) - header.frame_bytes + 2) / dv::recording::FRAME_ALIGN *
+                                        dv::recording::FRAME_ALIGN};
+    for (uint64_t offset : bad_offsets)
+    {
+        std::memcpy(&bytes[header.index_offset], &offset, sizeof(offset));
+        file = fopen("rec_bad.dvr", "wb");
+        fwrite(bytes.data(), 1, bytes.size(), file);
+        fclose(file);
+        if (reader.open("rec_bad.dvr"))
+        {
+            std::cerr << "Accepted frame offset " << offset << std::endl;
+            return -1;
+        }
+    }
+    std::remove("rec_bad.dvr");
+    std::remove("rec.dvr");
+    return 0;
+}
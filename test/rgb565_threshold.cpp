@@ -0,0 +1,74 @@
+#include <iostream>
+#include <cstring>
+
+#include <dv.hpp>
+#include <time.h>
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+
+    using dv::pixel_format::PixelFormat;
+    using dv::pixel_format::RGB565Pixel;
+
+    dv::image::Image<PixelFormat::RGB565, 320, 240> img_rgb565;
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    delete[] raw_data;
+
+    const RGB565Pixel t_low{4, 20, 2};
+    const RGB565Pixel t_high{28, 63, 20};
+
+    // 逐像素位域比较作为参照
+    auto expected = dv::image::Image<PixelFormat::Binary, 320, 240>();
+    auto time_0 = clock();
+    for (size_t y = 0; y < 240; ++y)
+    {
+        for (size_t x = 0; x < 320; ++x)
+        {
+            expected(x, y) = dv::pixel_format::in_range(img_rgb565(x, y), t_low, t_high) ? dv::pixel_format::BinaryPixel{255}
+                                                                                          : dv::pixel_format::BinaryPixel{0};
+        }
+    }
+    auto time_1 = clock();
+
+    auto bin_img = dv::image::Image<PixelFormat::Binary, 320, 240>();
+    dv::binaryzation::threshold(img_rgb565, bin_img, t_low, t_high);
+    auto time_2 = clock();
+    std::cout << "Per-pixel threshold " << double(time_1 - time_0) / CLOCKS_PER_SEC << " seconds, packed "
+              << double(time_2 - time_1) / CLOCKS_PER_SEC << " seconds" << std::endl;
+
+    if (std::memcmp(expected.get_data_ptr(), bin_img.get_data_ptr(), bin_img.get_data_size()) != 0)
+    {
+        std::cerr << "RGB565 threshold mismatch" << std::endl;
+        return -1;
+    }
+
+    // 单边阈值（上限为 max()）走同一路径
+    dv::binaryzation::threshold(img_rgb565, bin_img, t_low);
+    size_t count = 0;
+    for (size_t y = 0; y < 240; ++y)
+    {
+        for (size_t x = 0; x < 320; ++x)
+        {
+            bool pass = static_cast<uint8_t>(bin_img(x, y)) != 0;
+            if (pass != (img_rgb565(x, y) >= t_low))
+            {
+                std::cerr << "RGB565 single threshold mismatch" << std::endl;
+                return -1;
+            }
+            count += pass;
+        }
+    }
+    std::cout << "Pixels above low threshold: " << count << std::endl;
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+
+#include <dv.hpp>
+#include <time.h>
+
+using dv::pixel_format::PixelFormat;
+using dv::image::Image;
+using namespace dv::pixel_format;
+
+static Image<PixelFormat::RGB565, 320, 240> img_rgb565;
+static Image<PixelFormat::YUV422, 320, 240> yuv;
+static Image<PixelFormat::BayerRGGB, 320, 240> rggb;
+static Image<PixelFormat::BayerBGGR, 320, 240> bggr;
+static Image<PixelFormat::Grayscale, 320, 240> gray;
+static Image<PixelFormat::RGB, 320, 240> rgb;
+static Image<PixelFormat::LAB, 320, 240> lab;
+static Image<PixelFormat::Binary, 320, 240> mask;
+static Image<PixelFormat::RGB, 160, 120> half_rgb;
+static Image<PixelFormat::LAB, 160, 120> half_lab;
+
+// 双精度的 sRGB -> LAB，用来检查去马赛克后直接转换没有经过 RGB565 量化
+static LABPixel lab_reference(const RGBPixel &p)
+{
+    auto lin = [](double c)
+    { return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4); };
+    auto f = [](double t)
+    { const double d = 6.0 / 29.0; return t > d * d * d ? std::cbrt(t) : t / (3 * d * d) + 4.0 / 29.0; };
+    double r = lin(p.r / 255.0), g = lin(p.g / 255.0), b = lin(p.b / 255.0);
+    double fx = f((0.4124564 * r + 0.3575761 * g + 0.1804375 * b) / 0.95047);
+    double fy = f(0.2126729 * r + 0.7151522 * g + 0.0721750 * b);
+    double fz = f((0.0193339 * r + 0.1191920 * g + 0.9503041 * b) / 1.08883);
+    return LABPixel{static_cast<int8_t>(std::round(116 * fy - 16)), static_cast<int8_t>(std::round(500 * (fx - fy))),
+                    static_cast<int8_t>(std::round(200 * (fy - fz)))};
+}
+
+static bool close_lab(const LABPixel &a, const LABPixel &b)
+{
+    return std::abs(a.l - b.l) <= 1 && std::abs(a.a - b.a) <= 1 && std::abs(a.b - b.b) <= 1;
+}
+
+// 每个 2x2 单元的参考 RGB：R、B 直接取，两个 G 取平均
+template <typename Bayer>
+static RGBPixel quad(const Bayer &src, size_t x, size_t y, bool rggb_layout)
+{
+    size_t sx = x * 2, sy = y * 2;
+    uint8_t tl = src(sx, sy).value, tr = src(sx + 1, sy).value, bl = src(sx, sy + 1).value, br = src(sx + 1, sy + 1).value;
+    uint8_t g = static_cast<uint8_t>((tr + bl + 1) / 2);
+    return rggb_layout ? RGBPixel{tl, g, br} : RGBPixel{br, g, tl};
+}
+
+template <typename Bayer>
+static bool check_debayer(const Bayer &src, bool rggb_layout, const char *name)
+{
+    dv::sensor::debayer_half(src, half_rgb);
+    dv::sensor::debayer_half(src, half_lab);
+    for (size_t y = 0; y < 120; ++y)
+    {
+        for (size_t x = 0; x < 160; ++x)
+        {
+            RGBPixel ref = quad(src, x, y, rggb_layout);
+            const RGBPixel &out = half_rgb(x, y);
+            if (out.r != ref.r || out.g != ref.g || out.b != ref.b)
+            {
+                std::cerr << name << " debayer RGB mismatch at (" << x << ", " << y << ")" << std::endl;
+                return false;
+            }
+            if (!close_lab(half_lab(x, y), lab_reference(ref)))
+            {
+                std::cerr << name << " debayer LAB mismatch at (" << x << ", " << y << ")" << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+
+    // 由测试图像合成传感器数据：BT.601 全范围 YUYV，以及两种 Bayer 排列
+    for (size_t y = 0; y < 240; ++y)
+    {
+        for (size_t x = 0; x < 320; x += 2)
+        {
+            RGBPixel p0, p1;
+            pixel_cast(img_rgb565(x, y), p0);
+            pixel_cast(img_rgb565(x + 1, y), p1);
+            auto luma = [](const RGBPixel &p)
+            { return static_cast<uint8_t>((77 * p.r + 150 * p.g + 29 * p.b + 128) >> 8); };
+            int r = (p0.r + p1.r) / 2, g = (p0.g + p1.g) / 2, b = (p0.b + p1.b) / 2;
+            int u = 128 + ((-43 * r - 85 * g + 128 * b + 128) >> 8);
+            int v = 128 + ((128 * r - 107 * g - 21 * b + 128) >> 8);
+            yuv(x, y) = YUV422Pixel{luma(p0), static_cast<uint8_t>(u)};
+            yuv(x + 1, y) = YUV422Pixel{luma(p1), static_cast<uint8_t>(v)};
+        }
+    }
+    for (size_t y = 0; y < 240; ++y)
+    {
+        for (size_t x = 0; x < 320; ++x)
+        {
+            RGBPixel p;
+            pixel_cast(img_rgb565(x, y), p);
+            // 加一点噪声，让采样用满 8 位
+            int noise = std::rand() % 5 - 2;
+            auto sample = [noise](uint8_t c)
+            { return BayerPixel{static_cast<uint8_t>(std::min(255, std::max(0, c + noise)))}; };
+            bool even_x = x % 2 == 0, even_y = y % 2 == 0;
+            rggb(x, y) = sample(even_x == even_y ? (even_y ? p.r : p.b) : p.g);
+            bggr(x, y) = sample(even_x == even_y ? (even_y ? p.b : p.r) : p.g);
+        }
+    }
+
+    // Y 提取
+    dv::sensor::yuv422_to_gray(yuv, gray);
+    for (size_t y = 0; y < 240; ++y)
+        for (size_t x = 0; x < 320; ++x)
+            if (gray(x, y).value != yuv(x, y).y)
+            {
+                std::cerr << "Y extraction mismatch at (" << x << ", " << y << ")" << std::endl;
+                return -1;
+            }
+
+    // YUV422 -> RGB / LAB：每对像素共享偶数列的 U 和奇数列的 V
+    dv::sensor::yuv422_cast(yuv, rgb);
+    dv::sensor::yuv422_cast(yuv, lab);
+    for (size_t y = 0; y < 240; ++y)
+    {
+        for (size_t x = 0; x < 320; ++x)
+        {
+            size_t x0 = x & ~size_t(1);
+            RGBPixel ref = yuv_to_rgb(yuv(x, y).y, yuv(x0, y).c, yuv(x0 + 1, y).c);
+            if (rgb(x, y).r != ref.r || rgb(x, y).g != ref.g || rgb(x, y).b != ref.b || !close_lab(lab(x, y), lab_reference(ref)))
+            {
+                std::cerr << "YUV422 cast mismatch at (" << x << ", " << y << ")" << std::endl;
+                return -1;
+            }
+        }
+    }
+
+    if (!check_debayer(rggb, true, "RGGB") || !check_debayer(bggr, false, "BGGR"))
+        return -1;
+
+    // 色度阈值与逐像素 in_range 相同
+    const YUVPixel ranges[][2] = {{{0, 0, 0}, {255, 127, 255}}, {{40, 100, 100}, {220, 160, 160}}, {{0, 120, 0}, {255, 140, 255}}};
+    for (const auto &range : ranges)
+    {
+        dv::binaryzation::threshold(yuv, mask, range[0], range[1]);
+        const auto &result = mask;
+        size_t count = 0;
+        for (size_t y = 0; y < 240; ++y)
+        {
+            for (size_t x = 0; x < 320; ++x)
+            {
+                size_t x0 = x & ~size_t(1);
+                YUVPixel p{yuv(x, y).y, yuv(x0, y).c, yuv(x0 + 1, y).c};
+                bool expected = in_range(p, range[0], range[1]);
+                if ((result(x, y).value != 0) != expected)
+                {
+                    std::cerr << "YUV422 threshold mismatch at (" << x << ", " << y << ")" << std::endl;
+                    return -1;
+                }
+                count += expected;
+            }
+        }
+        std::cout << "YUV422 threshold: " << count << " pixels in range" << std::endl;
+    }
+
+    const int rounds = 100;
+    auto time_0 = clock();
+    for (int i = 0; i < rounds; ++i)
+        dv::sensor::debayer_half(rggb, half_lab);
+    auto time_1 = clock();
+    std::cout << "Bayer RGGB -> half-resolution LAB: " << double(time_1 - time_0) / CLOCKS_PER_SEC / rounds << " seconds" << std::endl;
+
+    delete[] raw_data;
+    return 0;
+}
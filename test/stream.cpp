@@ -0,0 +1,117 @@
+#include <iostream>
+#include <cstring>
+#include <cmath>
+
+#include <dv.hpp>
+#include <time.h>
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    const size_t width = 320;
+    const size_t height = 240;
+    uint8_t *raw_data = new uint8_t[width * height * 2];
+    fread(raw_data, 1, width * height * 2, file);
+    fclose(file);
+
+    using dv::pixel_format::PixelFormat;
+    using dv::pixel_format::LABPixel;
+    const LABPixel t_low{30, -128, 0};
+    const LABPixel t_high{100, -20, 127};
+
+    // 逐行处理：模拟相机 DMA 一行一行送数据
+    dv::pixel_format::RGB565Pixel rgb_row[width];
+    LABPixel lab_row[width];
+    dv::pixel_format::GrayscalePixel gray_row[width];
+    uint8_t bits[dv::stream::row_bytes<width>()];
+    dv::stream::RowHistogram<width> hist;
+    dv::stream::RunExtractor<width> runs;
+    auto streamed = dv::image::Image<PixelFormat::Binary, 320, 240>();
+
+    auto time_0 = clock();
+    hist.reset();
+    runs.reset();
+    for (size_t y = 0; y < height; ++y)
+    {
+        dv::stream::raw_to_rgb565_row<width>(raw_data + y * width * 2, rgb_row);
+        dv::stream::row_cast<width>(rgb_row, lab_row);
+        dv::stream::threshold_row<width>(lab_row, bits, t_low, t_high);
+        runs.push_row(y, bits);
+        dv::stream::row_cast<width>(rgb_row, gray_row);
+        hist.push_row(gray_row);
+        dv::stream::store_row(streamed, y, bits);
+    }
+    runs.finish();
+    auto time_1 = clock();
+
+    std::cout << "Streamed frame in " << double(time_1 - time_0) / CLOCKS_PER_SEC << " seconds, otsu threshold "
+              << static_cast<int>(hist.otsu()) << std::endl;
+    for (size_t i = 0; i < runs.blob_count(); ++i)
+    {
+        const auto &blob = runs.blob(i);
+        std::cout << "Blob " << i << ": area " << blob.area << " center (" << blob.cx() << ", " << blob.cy()
+                  << ") box [" << blob.x0 << ", " << blob.y0 << ", " << blob.x1 << ", " << blob.y1 << "]" << std::endl;
+        // 定点质心是精确均值四舍五入到 1/256
+        const uint64_t one = uint64_t(1) << dv::stream::Blob::CENTROID_FRAC_BITS;
+        if (blob.cx_fixed() != (blob.sum_x * one * 2 + blob.area) / (2 * blob.area) ||
+            blob.cy_fixed() != (blob.sum_y * one * 2 + blob.area) / (2 * blob.area) ||
+            std::fabs(blob.cx_fixed() / double(one) - blob.cx()) > 1.0 / one ||
+            std::fabs(blob.cy_fixed() / double(one) - blob.cy()) > 1.0 / one)
+        {
+            std::cerr << "Fixed-point centroid mismatch on blob " << i << std::endl;
+            return -1;
+        }
+    }
+
+    // 与整帧处理的结果对比
+    dv::image::Image<PixelFormat::RGB565, 320, 240> img_rgb565;
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    delete[] raw_data;
+    auto lab_img = dv::image::Image<PixelFormat::LAB, 320, 240>();
+    dv::image::image_cast(img_rgb565, lab_img);
+    auto bin_img = dv::image::Image<PixelFormat::Binary, 320, 240>();
+    dv::binaryzation::threshold(lab_img, bin_img, t_low, t_high);
+    if (std::memcmp(bin_img.get_data_ptr(), streamed.get_data_ptr(), bin_img.get_data_size()) != 0)
+    {
+        std::cerr << "Streamed mask mismatch" << std::endl;
+        return -1;
+    }
+
+    size_t area = 0;
+    for (size_t i = 0; i < runs.blob_count(); ++i)
+        area += runs.blob(i).area;
+    size_t expected = 0;
+    for (size_t y = 0; y < height; ++y)
+        for (size_t x = 0; x < width; ++x)
+            expected += static_cast<uint8_t>(bin_img(x, y)) != 0;
+    if (runs.dropped() == 0 && area != expected)
+    {
+        std::cerr << "Blob area mismatch" << std::endl;
+        return -1;
+    }
+    std::cout << "Blob pixels: " << area << " / " << expected << std::endl;
+
+    // 缩放：160x120 的行在对应的源行到达时立即输出
+    dv::stream::RowDownscale<dv::pixel_format::RGB565Pixel, 320, 240, 160, 120> downscale;
+    auto small = dv::image::Image<PixelFormat::RGB565, 160, 120>();
+    auto expected_small = dv::image::Image<PixelFormat::RGB565, 160, 120>();
+    dv::interpolation::nearest_neighbor(img_rgb565, expected_small);
+    for (size_t y = 0; y < height; ++y)
+    {
+        downscale.push_row(y, &img_rgb565(0, y), [&](size_t dy, const dv::pixel_format::RGB565Pixel *row)
+                           { std::memcpy(&small(0, dy), row, sizeof(dv::pixel_format::RGB565Pixel) * 160); });
+    }
+    if (std::memcmp(small.get_data_ptr(), expected_small.get_data_ptr(), small.get_data_size()) != 0)
+    {
+        std::cerr << "Streamed downscale mismatch" << std::endl;
+        return -1;
+    }
+    return 0;
+}
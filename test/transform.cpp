@@ -0,0 +1,155 @@
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+#include <dv.hpp>
+#include <time.h>
+
+using dv::pixel_format::PixelFormat;
+using dv::image::Image;
+
+// 逐像素的参照实现，结果与分块实现逐字节比较
+template <typename Src, typename Dst, typename Op, typename Map>
+static bool check(const char *name, const Src &src, Dst &dst, Op op, Map map)
+{
+    static Dst expected;
+    std::memset(expected.get_data_ptr(), 0, expected.get_data_size());
+    std::memset(dst.get_data_ptr(), 0, dst.get_data_size());
+    for (size_t y = 0; y < Src::image_height; ++y)
+    {
+        for (size_t x = 0; x < Src::image_width; ++x)
+        {
+            size_t dx, dy;
+            map(x, y, dx, dy);
+            expected(dx, dy) = src(x, y);
+        }
+    }
+    op(src, dst);
+    if (std::memcmp(expected.get_data_ptr(), dst.get_data_ptr(), dst.get_data_size()) != 0)
+    {
+        std::cerr << name << " mismatch (" << Src::image_width << "x" << Src::image_height << ", format "
+                  << static_cast<int>(Src::pixel_format) << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template <PixelFormat PF, size_t W, size_t H>
+static bool check_all(const Image<PF, W, H> &src)
+{
+    static Image<PF, H, W> rotated;
+    static Image<PF, W, H> mirrored;
+    bool ok = true;
+    ok &= check("transpose", src, rotated, [](auto &s, auto &d) { dv::transform::transpose(s, d); },
+                [](size_t x, size_t y, size_t &dx, size_t &dy) { dx = y; dy = x; });
+    ok &= check("rotate90", src, rotated, [](auto &s, auto &d) { dv::transform::rotate90(s, d); },
+                [](size_t x, size_t y, size_t &dx, size_t &dy) { dx = H - 1 - y; dy = x; });
+    ok &= check("rotate270", src, rotated, [](auto &s, auto &d) { dv::transform::rotate270(s, d); },
+                [](size_t x, size_t y, size_t &dx, size_t &dy) { dx = y; dy = W - 1 - x; });
+    ok &= check("rotate180", src, mirrored, [](auto &s, auto &d) { dv::transform::rotate180(s, d); },
+                [](size_t x, size_t y, size_t &dx, size_t &dy) { dx = W - 1 - x; dy = H - 1 - y; });
+    ok &= check("flip_horizontal", src, mirrored, [](auto &s, auto &d) { dv::transform::flip_horizontal(s, d); },
+                [](size_t x, size_t y, size_t &dx, size_t &dy) { dx = W - 1 - x; dy = y; });
+    ok &= check("flip_vertical", src, mirrored, [](auto &s, auto &d) { dv::transform::flip_vertical(s, d); },
+                [](size_t x, size_t y, size_t &dx, size_t &dy) { dx = x; dy = H - 1 - y; });
+    return ok;
+}
+
+template <typename ImageType>
+static void fill_random(ImageType &img)
+{
+    uint8_t *p = static_cast<uint8_t *>(img.get_data_ptr());
+    for (size_t i = 0; i < img.get_data_size(); ++i)
+        p[i] = static_cast<uint8_t>(std::rand());
+}
+
+static Image<PixelFormat::RGB565, 320, 240> img_rgb565;
+static Image<PixelFormat::RGB565, 240, 320> img_rotated;
+static Image<PixelFormat::RGB565, 240, 320> img_fused;
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    static Image<PixelFormat::Grayscale, 320, 240> gray;
+    static Image<PixelFormat::RGB, 320, 240> rgb;
+    static Image<PixelFormat::Binary, 320, 240> binary;
+    dv::image::image_cast(img_rgb565, gray);
+    dv::image::image_cast(img_rgb565, rgb);
+    dv::binaryzation::threshold(gray, binary, dv::pixel_format::GrayscalePixel{128}, dv::pixel_format::GrayscalePixel{255});
+
+    bool ok = check_all(gray) && check_all(img_rgb565) && check_all(rgb) && check_all(binary);
+
+    // 宽高不是 8 的倍数：走尾部和逐像素路径
+    static Image<PixelFormat::Grayscale, 37, 21> odd_gray;
+    static Image<PixelFormat::RGB565, 37, 21> odd_rgb565;
+    static Image<PixelFormat::Binary, 37, 21> odd_binary;
+    static Image<PixelFormat::Binary, 40, 20> half_binary;
+    fill_random(odd_gray);
+    fill_random(odd_rgb565);
+    for (size_t y = 0; y < 21; ++y)
+        for (size_t x = 0; x < 37; ++x)
+            odd_binary(x, y) = dv::pixel_format::BinaryPixel{static_cast<uint8_t>(std::rand() & 1 ? 255 : 0)};
+    for (size_t y = 0; y < 20; ++y)
+        for (size_t x = 0; x < 40; ++x)
+            half_binary(x, y) = dv::pixel_format::BinaryPixel{static_cast<uint8_t>(std::rand() & 1 ? 255 : 0)};
+    ok = ok && check_all(odd_gray) && check_all(odd_rgb565) && check_all(odd_binary) && check_all(half_binary);
+    if (!ok)
+        return -1;
+
+    // 读入时旋转与先读入再旋转结果相同
+    dv::transform::rotate90(img_rgb565, img_rotated);
+    dv::transform::raw_to_rgb565_rotate90(raw_data, img_fused);
+    if (std::memcmp(img_rotated.get_data_ptr(), img_fused.get_data_ptr(), img_fused.get_data_size()) != 0)
+    {
+        std::cerr << "Fused rotate90 ingestion mismatch" << std::endl;
+        return -1;
+    }
+    dv::transform::rotate270(img_rgb565, img_rotated);
+    dv::transform::raw_to_rgb565_rotate270(raw_data, img_fused);
+    if (std::memcmp(img_rotated.get_data_ptr(), img_fused.get_data_ptr(), img_fused.get_data_size()) != 0)
+    {
+        std::cerr << "Fused rotate270 ingestion mismatch" << std::endl;
+        return -1;
+    }
+
+    const int rounds = 100;
+    auto time_0 = clock();
+    for (int i = 0; i < rounds; ++i)
+    {
+        for (size_t y = 0; y < 240; ++y)
+            for (size_t x = 0; x < 320; ++x)
+                img_rotated(239 - y, x) = img_rgb565(x, y);
+    }
+    auto time_1 = clock();
+    for (int i = 0; i < rounds; ++i)
+        dv::transform::rotate90(img_rgb565, img_rotated);
+    auto time_2 = clock();
+    for (int i = 0; i < rounds; ++i)
+    {
+        dv::image::raw_to_rgb565(raw_data, img_rgb565);
+        dv::transform::rotate90(img_rgb565, img_rotated);
+    }
+    auto time_3 = clock();
+    for (int i = 0; i < rounds; ++i)
+        dv::transform::raw_to_rgb565_rotate90(raw_data, img_fused);
+    auto time_4 = clock();
+    std::cout << "RGB565 rotate90 per-pixel " << double(time_1 - time_0) / CLOCKS_PER_SEC / rounds
+              << " seconds, blocked " << double(time_2 - time_1) / CLOCKS_PER_SEC / rounds << " seconds" << std::endl;
+    std::cout << "Ingest + rotate90 " << double(time_3 - time_2) / CLOCKS_PER_SEC / rounds
+              << " seconds, fused " << double(time_4 - time_3) / CLOCKS_PER_SEC / rounds << " seconds" << std::endl;
+
+    delete[] raw_data;
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <iostream>
+#include <cstring>
+#include <cmath>
+
+#include <dv.hpp>
+#include <time.h>
+
+using dv::pixel_format::PixelFormat;
+
+static dv::undistort::RemapTable<320, 240> remap;
+
+int main()
+{
+    std::cout << "Dart Vision Test Suite" << std::endl;
+
+    auto file = fopen("img.bin", "rb");
+    if (!file)
+    {
+        std::cerr << "Failed to open img.bin" << std::endl;
+        return -1;
+    }
+    uint8_t *raw_data = new uint8_t[320 * 240 * 2];
+    fread(raw_data, 1, 320 * 240 * 2, file);
+    fclose(file);
+
+    dv::image::Image<PixelFormat::RGB565, 320, 240> img_rgb565;
+    dv::image::raw_to_rgb565(raw_data, img_rgb565);
+    delete[] raw_data;
+    auto gray = dv::image::Image<PixelFormat::Grayscale, 320, 240>();
+    dv::image::image_cast(img_rgb565, gray);
+
+    // 无畸变时重映射是恒等变换
+    dv::undistort::CameraModel ideal{300.0f, 300.0f, 159.5f, 119.5f};
+    remap.build(ideal);
+    auto out = dv::image::Image<PixelFormat::Grayscale, 320, 240>();
+    remap.apply(gray, out);
+    if (std::memcmp(gray.get_data_ptr(), out.get_data_ptr(), gray.get_data_size()) != 0)
+    {
+        std::cerr << "Identity remap changed the image" << std::endl;
+        return -1;
+    }
+
+    // 广角桶形畸变
+    dv::undistort::CameraModel cam{300.0f, 300.0f, 161.0f, 118.0f, -0.32f, 0.11f, 0.001f, -0.0005f, 0.0f};
+    auto time_0 = clock();
+    remap.build(cam);
+    auto time_1 = clock();
+    dv::image::ImageView<PixelFormat::Grayscale, 320, 240> out_view(out.get_data_ptr());
+    remap.apply(gray, out_view);
+    auto time_2 = clock();
+    auto rgb_out = dv::image::Image<PixelFormat::RGB565, 320, 240>();
+    remap.apply(img_rgb565, rgb_out);
+    auto time_3 = clock();
+    std::cout << "Table build " << double(time_1 - time_0) / CLOCKS_PER_SEC << " seconds, grayscale remap "
+              << double(time_2 - time_1) / CLOCKS_PER_SEC << " seconds, RGB565 remap "
+              << double(time_3 - time_2) / CLOCKS_PER_SEC << " seconds, valid pixels " << remap.valid_count() << std::endl;
+
+    // 表项与畸变模型一致（1/16 像素以内），输出是对应位置的双线性插值
+    for (size_t y = 0; y < 240; y += 7)
+    {
+        for (size_t x = 0; x < 320; x += 7)
+        {
+            auto e = remap.entry(x, y);
+            if (e.x == remap.INVALID)
+                continue;
+            auto d = dv::undistort::distort_point(cam, {static_cast<float>(x), static_cast<float>(y)});
+            if (std::fabs(e.x / 16.0f - d.x) > 1.0f / 32 + 1e-3f || std::fabs(e.y / 16.0f - d.y) > 1.0f / 32 + 1e-3f)
+            {
+                std::cerr << "Remap entry mismatch at (" << x << ", " << y << ")" << std::endl;
+                return -1;
+            }
+            float fx = (e.x % 16) / 16.0f, fy = (e.y % 16) / 16.0f;
+            size_t x0 = e.x / 16, y0 = e.y / 16, x1 = std::min<size_t>(x0 + 1, 319), y1 = std::min<size_t>(y0 + 1, 239);
+            float expected = gray(x0, y0).value * (1 - fx) * (1 - fy) + gray(x1, y0).value * fx * (1 - fy) +
+                             gray(x0, y1).value * (1 - fx) * fy + gray(x1, y1).value * fx * fy;
+            if (std::fabs(out(x, y).value - expected) > 1.0f)
+            {
+                std::cerr << "Bilinear sample mismatch at (" << x << ", " << y << ")" << std::endl;
+                return -1;
+            }
+        }
+    }
+
+    // 稀疏模式：去畸变后再加畸变回到原位置
+    dv::stream::Blob blobs[3] = {};
+    const float centers[3][2] = {{10.0f, 12.0f}, {160.0f, 120.0f}, {300.0f, 220.0f}};
+    for (int i = 0; i < 3; ++i)
+    {
+        blobs[i].area = 4;
+        blobs[i].sum_x = static_cast<uint64_t>(centers[i][0] * 4);
+        blobs[i].sum_y = static_cast<uint64_t>(centers[i][1] * 4);
+    }
+    dv::undistort::Point points[3];
+    dv::undistort::undistort_centroids(cam, blobs, 3, points);
+    for (int i = 0; i < 3; ++i)
+    {
+        auto back = dv::undistort::distort_point(cam, points[i]);
+        std::cout << "Centroid (" << centers[i][0] << ", " << centers[i][1] << ") -> (" << points[i].x << ", "
+                  << points[i].y << ")" << std::endl;
+        if (std::fabs(back.x - centers[i][0]) > 0.05f || std::fabs(back.y - centers[i][1]) > 0.05f)
+        {
+            std::cerr << "Sparse undistortion did not converge" << std::endl;
+            return -1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,33 @@
+// 生成整数构建（DV_INTEGER_ONLY）使用的 RGB565 -> LAB 表 include/dv/rgb565_lab_table.inc。
+// 表随源码提交，交叉编译时不需要在主机上运行任何东西；修改 LAB 的浮点实现后在主机上重新生成：
+//   cmake --build <build> --target lab_table
+// 两种构建都使用这张表；CMake 用 -ffp-contract=off 编译本工具，结果不随主机的 FMA 变化，
+// test/integer.cpp 检查提交的表没有过期。
+#undef DV_INTEGER_ONLY
+
+#include <cstdio>
+
+#include "dv/pixel_format.hpp"
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        std::fprintf(stderr, "usage: %s <output.inc>\n", argv[0]);
+        return -1;
+    }
+    auto file = std::fopen(argv[1], "w");
+    if (!file)
+    {
+        std::fprintf(stderr, "Failed to open %s for writing\n", argv[1]);
+        return -1;
+    }
+    const auto table = dv::pixel_format::rgb565_to_lab_lookup_tables_init_();
+    std::fprintf(file, "// generated by tools/gen_lab_table.cpp, do not edit\n");
+    for (size_t i = 0; i < table.size(); ++i)
+    {
+        std::fprintf(file, "{%d,%d,%d},%s", table[i].l, table[i].a, table[i].b, i % 16 == 15 ? "\n" : "");
+    }
+    std::fclose(file);
+    return 0;
+}